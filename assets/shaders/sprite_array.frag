@@ -0,0 +1,13 @@
+#version 430 core
+
+in  vec2 vUV;
+in  vec4 vColor;
+flat in uint vLayer;
+out vec4 FragColor;
+
+uniform sampler2DArray uTextures;
+
+void main()
+{
+    FragColor = texture(uTextures, vec3(vUV, float(vLayer))) * vColor;
+}
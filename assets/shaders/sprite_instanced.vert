@@ -0,0 +1,33 @@
+#version 430 core
+
+// One instance per sprite. The quad is expanded here from gl_VertexID, drawn as a 4-vertex triangle strip.
+layout(location = 0) in vec2  aPosition;
+layout(location = 1) in vec2  aSize;
+layout(location = 2) in vec2  aAnchor;
+layout(location = 3) in float aRotation;
+layout(location = 4) in float aDepth;
+layout(location = 5) in vec4  aUVRect; // xy = UV min, zw = UV size.
+layout(location = 6) in vec4  aTint;
+layout(location = 7) in uint  aLayer;  // Texture array layer; ignored by sprite.frag.
+
+uniform mat4 uTransform;
+
+out vec2 vUV;
+out vec4 vColor;
+flat out uint vLayer;
+
+void main()
+{
+    vec2  corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+    // Rotating about the origin and then offsetting by the rotated origin-to-anchor vector is a rotation about the anchor.
+    vec2  local  = (corner - aAnchor) * aSize;
+    float s      = sin(aRotation);
+    float c      = cos(aRotation);
+    vec2  world  = aPosition + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    vUV    = aUVRect.xy + corner * aUVRect.zw;
+    vColor = aTint;
+    vLayer = aLayer;
+    gl_Position = uTransform * vec4(world, aDepth, 1.0);
+}
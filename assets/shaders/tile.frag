@@ -0,0 +1,13 @@
+#version 430 core
+
+in vec2 vRepeat;
+flat in vec4 vTileRect;
+out vec4 FragColor;
+
+uniform sampler2D uTexture0;
+
+// vRepeat counts tiles across the quad; wrapping it repeats one atlas tile (xy = UV min, zw = UV size) over merged quads.
+void main()
+{
+    FragColor = texture(uTexture0, vTileRect.xy + fract(vRepeat) * vTileRect.zw);
+}
@@ -0,0 +1,18 @@
+#version 430 core
+
+layout(location = 0) in vec2  aPos;
+layout(location = 1) in vec2  aRepeat;
+layout(location = 2) in vec4  aTileRect;
+layout(location = 3) in float aDepth;
+
+uniform mat4 uTransform;
+
+out vec2 vRepeat;
+flat out vec4 vTileRect;
+
+void main()
+{
+    vRepeat   = aRepeat;
+    vTileRect = aTileRect;
+    gl_Position = uTransform * vec4(aPos, aDepth, 1.0);
+}
@@ -0,0 +1,39 @@
+# te_embed_shaders(OUTPUT <header> DIRECTORY <dir>)
+#
+# Writes every `.vert` / `.frag` in DIRECTORY into OUTPUT as raw string literals, so the engine carries default copies of its shaders.
+# Generated at configure time; editing or adding a shader re-runs the configure step on the next build.
+function(te_embed_shaders)
+    cmake_parse_arguments(EMBED "" "OUTPUT;DIRECTORY" "" ${ARGN})
+
+    file(GLOB shaderFiles CONFIGURE_DEPENDS "${EMBED_DIRECTORY}/*.vert" "${EMBED_DIRECTORY}/*.frag")
+    list(SORT shaderFiles)
+
+    set(entries "")
+    foreach(shaderFile IN LISTS shaderFiles)
+        get_filename_component(shaderName "${shaderFile}" NAME)
+        file(READ "${shaderFile}" shaderSource)
+
+        if(shaderSource MATCHES "\\)TE_SHADER\"")
+            message(FATAL_ERROR "Shader '${shaderName}' contains the raw string delimiter ')TE_SHADER\"'.")
+        endif()
+
+        string(APPEND entries "        { \"${shaderName}\", R\"TE_SHADER(${shaderSource})TE_SHADER\" },\n")
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${shaderFile}")
+    endforeach()
+
+    set(header "// Generated by cmake/EmbedShaders.cmake from assets/shaders. Do not edit.\n")
+    string(APPEND header "#ifndef TERRANENGINE_EMBEDDEDSHADERS_H\n#define TERRANENGINE_EMBEDDEDSHADERS_H\n\n#include <string_view>\n\n")
+    string(APPEND header "namespace TerranEngine::EmbeddedShaders\n{\n")
+    string(APPEND header "    struct Entry\n    {\n        std::string_view name;\n        std::string_view source;\n    };\n\n")
+    string(APPEND header "    inline constexpr Entry Entries[] =\n    {\n${entries}    };\n}\n\n#endif // TERRANENGINE_EMBEDDEDSHADERS_H\n")
+
+    # Only rewrite on change, so an unrelated reconfigure does not rebuild everything including it.
+    set(previous "")
+    if(EXISTS "${EMBED_OUTPUT}")
+        file(READ "${EMBED_OUTPUT}" previous)
+    endif()
+
+    if(NOT previous STREQUAL header)
+        file(WRITE "${EMBED_OUTPUT}" "${header}")
+    endif()
+endfunction()
@@ -4,7 +4,13 @@
 #include "engine/ecs/world/HierarchySystem.h"
 #include "engine/ecs/ScriptSystem.h"
 #include "engine/ecs/CameraSystem.h"
+#include "engine/ecs/CollisionSystem.h"
+#include "engine/ecs/SpatialHashSystem.h"
+#include "engine/ecs/ChunkStreamer.h"
+#include "engine/ecs/ParticleSystem.h"
+#include "engine/ecs/VisibilitySystem.h"
 #include "engine/gfx/SpriteRenderer.h"
+#include "engine/gfx/TilemapRenderer.h"
 
 #include <algorithm>
 
@@ -21,11 +27,20 @@ namespace TerranEngine
         world = std::make_unique<World>();
 
         world->AddSystem<HierarchySystem>();
+        world->AddSystem<FixedScriptSystem>(SystemPhase::FIXEDUPDATE, 0);
         world->AddSystem<ScriptSystem>();
-        world->AddSystem<SpriteRenderer>(SystemPhase::RENDER, 0);
+        world->AddSystem<TilemapRenderer>(SystemPhase::RENDER, -1);
+        world->AddSystem<SpriteRenderer>(SystemPhase::RENDER, 0, workers);
         world->AddSystem<CameraSystem>(SystemPhase::UPDATE, 0, windowManager);
+        world->AddSystem<ParticleSystem>(SystemPhase::UPDATE, 0);
+        world->AddSystem<SpatialHashSystem>(SystemPhase::POSTUPDATE, 0);
+        world->AddSystem<CollisionSystem>(SystemPhase::POSTUPDATE, 0, workers);
+        world->AddSystem<VisibilitySystem>(SystemPhase::POSTUPDATE, 0);
+        world->AddSystem<ChunkStreamer>(SystemPhase::POSTUPDATE, 0, workers);
 
         Time::Init();
+        Time::SetMaxFixedTicks(config.maxFixedTicks);
+        memoryLogInterval = config.memoryLogInterval;
         running = true;
 
         TE_LOG_INFO("Initialisation complete ({}x{} native-resolution | {}x{} window-resolution).", config.nativeWidth, config.nativeHeight, config.windowWidth, config.windowHeight);
@@ -52,6 +67,16 @@ namespace TerranEngine
         world->UpdateSystems(deltaTime);
         windowManager.EndFrame();
 
+        if (memoryLogInterval > 0.0f)
+        {
+            memoryLogTimer += Time::DeltaTimeUnscaled();
+            if (memoryLogTimer >= memoryLogInterval)
+            {
+                memoryLogTimer = 0.0f;
+                world->MemoryStats().Log();
+            }
+        }
+
         Input::NewFrame();
     }
 
@@ -76,8 +101,9 @@ namespace TerranEngine
     {
         TE_LOG_INFO("Shutting down application...");
 
-        windowManager.Shutdown();
+        // Systems own GL objects (buffers, programs, fences), so they are destroyed while the window's context is still current.
         world.reset();
+        windowManager.Shutdown();
         running = false;
 
         TE_LOG_INFO("Goodbye!");
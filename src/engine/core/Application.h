@@ -6,6 +6,7 @@
 #include "engine/core/Time.h"
 #include "engine/core/Log.h"
 #include "engine/core/Config.h"
+#include "engine/core/ThreadPool.h"
 #include "engine/ecs/world/World.h"
 #include "engine/gfx/WindowManager.h"
 
@@ -33,6 +34,9 @@ namespace TerranEngine
 
         void SetActiveWorld(std::unique_ptr<World> world) noexcept { this->world = std::move(world); }
 
+        /** The engine's worker threads, shared by every System that runs work off the main thread. */
+        [[nodiscard]] ThreadPool& GetThreadPool() noexcept { return workers; }
+
         /** Enter the main loop. Returns when game has been quit. */
         void Run() noexcept;
 
@@ -52,8 +56,13 @@ namespace TerranEngine
     private:
         // --- Window state --- //
         WindowManager          windowManager;
+        ThreadPool             workers; // Declared before `world`, so it outlives every System using it.
         std::unique_ptr<World> world;
 
+        // --- Diagnostics --- //
+        float memoryLogInterval {0.0f};
+        float memoryLogTimer    {0.0f};
+
         bool running {false};
     };
 }
@@ -7,15 +7,17 @@ namespace TerranEngine
 {
     struct Config
     {
-        std::string title        {"TerranEngine"};
-        int         nativeWidth  {480};
-        int         nativeHeight {270};
-        int         windowWidth  {1280};
-        int         windowHeight {720};
-        bool        fullscreen   {true};
-        bool        resizable    {false};
-        bool        vsync        {false};
-        bool        growViewport {true};
+        std::string title             {"TerranEngine"};
+        int         nativeWidth       {480};
+        int         nativeHeight      {270};
+        int         windowWidth       {1280};
+        int         windowHeight      {720};
+        bool        fullscreen        {true};
+        bool        resizable         {false};
+        bool        vsync             {false};
+        bool        growViewport      {true};
+        int         maxFixedTicks     {8};    // Fixed-tick catch-up cap per frame (see `Time::SetMaxFixedTicks`).
+        float       memoryLogInterval {0.0f}; // Seconds between `World::MemoryStats()` logs. 0 disables.
     };
 }
 
@@ -0,0 +1,130 @@
+#include "engine/core/MappedFile.h"
+
+#include "engine/core/Log.h"
+
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace TerranEngine
+{
+    MappedFile::MappedFile(MappedFile&& otherFile) noexcept { *this = std::move(otherFile); }
+
+    MappedFile& MappedFile::operator=(MappedFile&& otherFile) noexcept
+    {
+        if (this == &otherFile) { return *this; }
+
+        Close();
+
+        data   = std::exchange(otherFile.data, nullptr);
+        size   = std::exchange(otherFile.size, 0);
+        opened = std::exchange(otherFile.opened, false);
+
+#if defined(_WIN32)
+        fileHandle    = std::exchange(otherFile.fileHandle, nullptr);
+        mappingHandle = std::exchange(otherFile.mappingHandle, nullptr);
+#endif
+
+        return *this;
+    }
+
+#if defined(_WIN32)
+    bool MappedFile::Open(std::string_view filePath)
+    {
+        Close();
+
+        const std::string path {filePath};
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) { TE_LOG_ERROR("MappedFile: Failed to open '{}'.", filePath); return false; }
+
+        LARGE_INTEGER fileSize {};
+        if (!GetFileSizeEx(file, &fileSize)) { TE_LOG_ERROR("MappedFile: Failed to query the size of '{}'.", filePath); CloseHandle(file); return false; }
+
+        fileHandle = file;
+        size       = static_cast<size_t>(fileSize.QuadPart);
+        opened     = true;
+
+        // Empty files cannot be mapped, but are valid.
+        if (!size) { return true; }
+
+        mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle) { data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0); }
+
+        if (!data) { TE_LOG_ERROR("MappedFile: Failed to map '{}'.", filePath); Close(); return false; }
+
+        return true;
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (data)          { UnmapViewOfFile(data); }
+        if (mappingHandle) { CloseHandle(mappingHandle); }
+        if (fileHandle)    { CloseHandle(fileHandle); }
+
+        data          = nullptr;
+        mappingHandle = nullptr;
+        fileHandle    = nullptr;
+        size          = 0;
+        opened        = false;
+    }
+#else
+    bool MappedFile::Open(std::string_view filePath)
+    {
+        Close();
+
+        const std::string path {filePath};
+
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) { TE_LOG_ERROR("MappedFile: Failed to open '{}'.", filePath); return false; }
+
+        struct stat status {};
+        if (::fstat(file, &status) != 0) { TE_LOG_ERROR("MappedFile: Failed to query the size of '{}'.", filePath); ::close(file); return false; }
+
+        size   = static_cast<size_t>(status.st_size);
+        opened = true;
+
+        // Empty files cannot be mapped, but are valid. The mapping stays valid after the descriptor is closed.
+        if (size)
+        {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping == MAP_FAILED)
+            {
+                TE_LOG_ERROR("MappedFile: Failed to map '{}'.", filePath);
+                ::close(file);
+                size   = 0;
+                opened = false;
+                return false;
+            }
+
+            data = mapping;
+        }
+
+        ::close(file);
+        return true;
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (data) { ::munmap(const_cast<void*>(data), size); }
+
+        data   = nullptr;
+        size   = 0;
+        opened = false;
+    }
+#endif
+}
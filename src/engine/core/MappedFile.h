@@ -0,0 +1,47 @@
+#ifndef TERRANENGINE_MAPPEDFILE_H
+#define TERRANENGINE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The contents are paged in by the OS on first access, so opening a file costs the same regardless of its size, and nothing is copied.
+     * The mapping starts on a page boundary, so data at aligned offsets inside the file can be read in place.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        MappedFile(MappedFile&& otherFile) noexcept;
+        MappedFile& operator=(MappedFile&& otherFile) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /** Map `filePath`, closing any previous mapping. Returns false (and logs) on failure. */
+        bool Open(std::string_view filePath);
+        void Close() noexcept;
+
+        [[nodiscard]] bool                       IsOpen() const noexcept { return opened; }
+        [[nodiscard]] std::span<const std::byte> Bytes()  const noexcept { return { static_cast<const std::byte*>(data), size }; }
+        [[nodiscard]] size_t                     Size()   const noexcept { return size; }
+
+    private:
+        const void* data   {nullptr};
+        size_t      size   {0};
+        bool        opened {false};
+
+#if defined(_WIN32)
+        void* fileHandle    {nullptr};
+        void* mappingHandle {nullptr};
+#endif
+    };
+}
+
+#endif // TERRANENGINE_MAPPEDFILE_H
@@ -0,0 +1,52 @@
+#include "engine/core/MemoryReport.h"
+
+#include "engine/core/Log.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace TerranEngine
+{
+    MemoryUsage MemoryReport::Total() const noexcept
+    {
+        MemoryUsage total;
+        for (const Entry& entry : entries) { total += entry.usage; }
+
+        return total;
+    }
+
+    void MemoryReport::Log() const
+    {
+        std::vector<const Entry*> sorted;
+        sorted.reserve(entries.size());
+        for (const Entry& entry : entries) { sorted.push_back(&entry); }
+
+        std::ranges::sort(sorted, [](const Entry* a, const Entry* b) { return a->usage.reserved > b->usage.reserved; });
+
+        for (const Entry* entry : sorted)
+        {
+            TE_LOG_INFO("Memory | {:<40} used {:>10.1f} KiB | reserved {:>10.1f} KiB | wasted {:>10.1f} KiB", entry->name, entry->usage.used / 1024.0, entry->usage.reserved / 1024.0, entry->usage.Wasted() / 1024.0);
+        }
+
+        const MemoryUsage total = Total();
+        TE_LOG_INFO("Memory | {:<40} used {:>10.1f} KiB | reserved {:>10.1f} KiB | wasted {:>10.1f} KiB", "Total", total.used / 1024.0, total.reserved / 1024.0, total.Wasted() / 1024.0);
+    }
+
+    bool MemoryReport::Dump(std::string_view filePath) const
+    {
+        std::ofstream file {std::string(filePath)};
+        if (!file)
+        {
+            TE_LOG_ERROR("MemoryReport: Failed to open '{}' for writing.", filePath);
+            return false;
+        }
+
+        file << "name,used,reserved,wasted\n";
+        for (const Entry& entry : entries)
+        {
+            file << '"' << entry.name << "\"," << entry.usage.used << ',' << entry.usage.reserved << ',' << entry.usage.Wasted() << '\n';
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef TERRANENGINE_MEMORYREPORT_H
+#define TERRANENGINE_MEMORYREPORT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TerranEngine
+{
+    /** Bytes held by a single allocation or container: `used` holds live data, `reserved` is what is actually allocated. */
+    struct MemoryUsage
+    {
+        size_t used     {0};
+        size_t reserved {0};
+
+        [[nodiscard]] size_t Wasted() const noexcept { return reserved > used ? reserved - used : 0; }
+
+        MemoryUsage& operator+=(const MemoryUsage& other) noexcept { used += other.used; reserved += other.reserved; return *this; }
+    };
+
+    /** Usage of a `std::vector`, counting `usedCount` elements as live (defaults to its size). */
+    template<typename Vector>
+    [[nodiscard]] MemoryUsage VectorMemory(const Vector& vector, size_t usedCount) noexcept
+    {
+        using Element = typename Vector::value_type;
+        return { usedCount * sizeof(Element), vector.capacity() * sizeof(Element) };
+    }
+
+    template<typename Vector>
+    [[nodiscard]] MemoryUsage VectorMemory(const Vector& vector) noexcept { return VectorMemory(vector, vector.size()); }
+
+    /**
+     * @brief Named list of `MemoryUsage` entries gathered from engine subsystems.
+     *
+     * Subsystems append their entries through `ReportMemory(MemoryReport&)` (see `World::MemoryStats()`).
+     * Entry names are grouped by a `Group/Name` convention, e.g. `Pool/Transform2D sparse`.
+     */
+    class MemoryReport
+    {
+    public:
+        struct Entry
+        {
+            std::string name;
+            MemoryUsage usage;
+        };
+
+        void Add(std::string_view name, const MemoryUsage& usage) { entries.push_back({std::string(name), usage}); }
+
+        [[nodiscard]] const std::vector<Entry>& Entries() const noexcept { return entries; }
+        [[nodiscard]] MemoryUsage Total() const noexcept;
+
+        /** Log every entry (largest reservation first) and the total at info level. */
+        void Log() const;
+
+        /** Write the report as CSV (`name,used,reserved,wasted`). Returns false if the file cannot be opened. */
+        bool Dump(std::string_view filePath) const;
+
+    private:
+        std::vector<Entry> entries;
+    };
+}
+
+#endif // TERRANENGINE_MEMORYREPORT_H
@@ -0,0 +1,118 @@
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace TerranEngine
+{
+    ThreadPool::ThreadPool(size_t workerCount)
+        : workerCount(workerCount ? workerCount : std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1)
+    {
+    }
+
+    void ThreadPool::Start()
+    {
+        std::call_once(started, [this]
+        {
+            workers.reserve(workerCount);
+            for (size_t i = 0; i < workerCount; ++i) { workers.emplace_back(&ThreadPool::WorkerLoop, this); }
+        });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock {mutex};
+            stopping = true;
+            jobs.clear();
+        }
+
+        wake.notify_all();
+        for (std::thread& worker : workers) { worker.join(); }
+    }
+
+    void ThreadPool::Submit(std::function<void()> job)
+    {
+        Start();
+
+        {
+            std::lock_guard lock {mutex};
+            jobs.push_back(std::move(job));
+        }
+
+        wake.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& body)
+    {
+        if (!count) { return; }
+
+        // A few chunks per thread evens out uneven items without much contention on the chunk counter.
+        const size_t threads    = workerCount + 1;
+        const size_t chunkSize  = std::max({minChunk, size_t {1}, (count + threads * 4 - 1) / (threads * 4)});
+        const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount == 1 || !workerCount)
+        {
+            body(0, count);
+            return;
+        }
+
+        struct Progress
+        {
+            std::atomic<size_t> next {0};
+            std::atomic<size_t> done {0};
+        };
+
+        // Shared, since a helper may only start after the caller has returned. It then finds no chunks left and never touches `body`.
+        auto progress = std::make_shared<Progress>();
+
+        auto work = [progress, &body, count, chunkSize, chunkCount]
+        {
+            for (size_t chunk; (chunk = progress->next.fetch_add(1, std::memory_order_relaxed)) < chunkCount;)
+            {
+                const size_t begin = chunk * chunkSize;
+                body(begin, std::min(count, begin + chunkSize));
+
+                if (progress->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunkCount) { progress->done.notify_one(); }
+            }
+        };
+
+        for (size_t helper = 1; helper < std::min(threads, chunkCount); ++helper) { Submit(work); }
+        work();
+
+        for (size_t done; (done = progress->done.load(std::memory_order_acquire)) < chunkCount;)
+        {
+            progress->done.wait(done, std::memory_order_acquire);
+        }
+    }
+
+    size_t ThreadPool::CancelPending()
+    {
+        std::lock_guard lock {mutex};
+
+        const size_t dropped = jobs.size();
+        jobs.clear();
+        return dropped;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock {mutex};
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+                if (stopping) { return; }
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            job();
+        }
+    }
+}
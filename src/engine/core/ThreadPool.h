@@ -0,0 +1,63 @@
+#ifndef TERRANENGINE_THREADPOOL_H
+#define TERRANENGINE_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Fixed set of worker threads running submitted jobs in FIFO order.
+     *
+     * Jobs must not touch the World or any GL state; they hand their results back to the main thread (e.g. through a queue the submitting System drains).
+     * `ParallelFor` is the exception: the caller blocks until every chunk is done, so its body may read the World and write into mapped buffers.
+     * Destroying the pool discards jobs that have not started yet and waits for running ones to finish.
+     *
+     * Threads start with the first job, so a pool that is never given work (e.g. no streamed map, and frames too small to split) costs nothing.
+     */
+    class ThreadPool
+    {
+    public:
+        /** `workerCount = 0` uses one worker per hardware thread, minus one for the main thread. No thread starts until the first job. */
+        explicit ThreadPool(size_t workerCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> job);
+
+        /**
+         * Run `body(begin, end)` over `[0, count)` in chunks of at least `minChunk` on the workers and the calling thread, and return once
+         * every chunk is done. The caller takes chunks too, so this finishes even while every worker is busy with other jobs.
+         */
+        void ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& body);
+
+        /** Drop every job that has not started yet. Returns the number dropped. */
+        size_t CancelPending();
+
+        /** Workers the pool runs once started. */
+        [[nodiscard]] size_t WorkerCount() const noexcept { return workerCount; }
+
+    private:
+        void Start();
+        void WorkerLoop();
+
+    private:
+        size_t                            workerCount {0};
+        std::once_flag                    started;
+        std::vector<std::thread>          workers;
+        std::deque<std::function<void()>> jobs;
+
+        std::mutex              mutex;
+        std::condition_variable wake;
+        bool                    stopping {false};
+    };
+}
+
+#endif // TERRANENGINE_THREADPOOL_H
@@ -1,5 +1,7 @@
 #include "engine/core/Time.h"
 
+#include <cmath>
+
 namespace TerranEngine
 {
     using clock = std::chrono::high_resolution_clock;
@@ -36,11 +38,18 @@ namespace TerranEngine
         fixedTickCount = 0;
 
         // Check for how many fixed-steps took place within the tick.
-        while (accumulator >= targetFixedDelta)
+        while (accumulator >= targetFixedDelta && fixedTickCount < maxFixedTicks)
         {
             accumulator -= targetFixedDelta;
             ++fixedTickCount;
         }
+
+        // Spiral-of-death protection: drop whole steps past the cap, keeping the fractional remainder so the interpolation alpha stays continuous.
+        if (accumulator >= targetFixedDelta)
+        {
+            droppedFixedTicks += static_cast<uint64_t>(accumulator / targetFixedDelta);
+            accumulator = std::fmod(accumulator, targetFixedDelta);
+        }
     }
 
     int Time::ConsumeFixedTicks() noexcept
@@ -2,6 +2,7 @@
 #define TERRANENGINE_TIME_H
 
 #include <chrono>
+#include <cstdint>
 
 namespace TerranEngine
 {
@@ -36,6 +37,16 @@ namespace TerranEngine
         /** The amount of fixed ticks to consume this frame. */
         [[nodiscard]] static int ConsumeFixedTicks() noexcept;
 
+        /** Fraction (0-1) of a fixed step left in the accumulator after this frame's ticks. Used to interpolate rendering between fixed states. */
+        [[nodiscard]] static float FixedAlpha() noexcept { return static_cast<float>(accumulator / targetFixedDelta); }
+
+        /** Upper bound on fixed ticks per frame. Time beyond it is dropped so a long stall cannot queue a spiral of catch-up ticks. */
+        static void SetMaxFixedTicks(int maxTicks) noexcept { maxFixedTicks = maxTicks < 1 ? 1 : maxTicks; }
+        [[nodiscard]] static int MaxFixedTicks()   noexcept { return maxFixedTicks; }
+
+        /** Total fixed ticks dropped by the catch-up clamp since initialisation. */
+        [[nodiscard]] static uint64_t DroppedFixedTicks() noexcept { return droppedFixedTicks; }
+
         /** Total seconds since initialisation. */
         [[nodiscard]] static double TotalTime() noexcept;
 
@@ -57,8 +68,11 @@ namespace TerranEngine
         inline static double deltaTime      = 0.0;
         inline static double accumulator    = 0.0;
         inline static int    fixedTickCount = 0;
+        inline static int    maxFixedTicks  = 8;
         inline static float  timeScale      = 1.0f;
 
+        inline static uint64_t droppedFixedTicks = 0;
+
         static constexpr double targetFixedDelta = 1.0 / 60.0;
 
         inline static double fpsTimer      = 0.0;
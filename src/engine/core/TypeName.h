@@ -0,0 +1,32 @@
+#ifndef TERRANENGINE_TYPENAME_H
+#define TERRANENGINE_TYPENAME_H
+
+#include <string_view>
+
+namespace TerranEngine
+{
+    /** Readable, compile-time name of type T (e.g. `Transform2D`), parsed from the compiler's function signature. Namespace qualification varies by compiler. */
+    template<typename T>
+    constexpr std::string_view TypeName() noexcept
+    {
+        #if defined(__clang__) || defined(__GNUC__)
+            // "... TypeName() [with T = TerranEngine::Transform2D; ...]" (GCC) or "... TypeName() [T = TerranEngine::Transform2D]" (Clang).
+            constexpr std::string_view signature = __PRETTY_FUNCTION__;
+            constexpr size_t first = signature.find("T = ") + 4;
+            constexpr size_t last  = signature.find_first_of(";]", first);
+        #elif defined(_MSC_VER)
+            // "... TypeName<struct TerranEngine::Transform2D>(void) noexcept".
+            constexpr std::string_view signature = __FUNCSIG__;
+            constexpr size_t first = signature.find("TypeName<") + 9;
+            constexpr size_t last  = signature.rfind(">(");
+        #else
+            constexpr std::string_view signature = "unknown";
+            constexpr size_t first = 0;
+            constexpr size_t last  = signature.size();
+        #endif
+
+        return signature.substr(first, last - first);
+    }
+}
+
+#endif // TERRANENGINE_TYPENAME_H
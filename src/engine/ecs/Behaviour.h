@@ -38,6 +38,7 @@ namespace TerranEngine
         bool awake   {false};
         bool started {false};
         friend class ScriptSystem;
+        friend class FixedScriptSystem;
 
     };
 
@@ -7,12 +7,16 @@
 
 namespace TerranEngine
 {
+    void CameraSystem::Bind(World& world) { world.BindQuery(cameras); }
+
     void CameraSystem::Update(World& world, float)
     {
+        Bind(world);
+
         const int viewportWidth  = windowManager.ViewportWidth();
         const int viewportHeight = windowManager.ViewportHeight();
 
-        world.ForEach<Transform2D, Camera2D>([viewportWidth, viewportHeight](Entity, Transform2D& transform, Camera2D& camera)
+        cameras.ForEach([viewportWidth, viewportHeight](Entity, Transform2D& transform, Camera2D& camera)
         {
             camera.viewportWidth  = viewportWidth;
             camera.viewportHeight = viewportHeight;
@@ -26,6 +30,8 @@ namespace TerranEngine
             const float top    = snappedY + static_cast<float>(viewportHeight);
 
             camera.viewProjection = glm::ortho(left, right, bottom, top);
+            camera.viewMin        = { left, bottom };
+            camera.viewMax        = { right, top };
         });
     }
 }
\ No newline at end of file
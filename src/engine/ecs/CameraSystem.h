@@ -3,6 +3,7 @@
 
 #include "engine/gfx/WindowManager.h"
 #include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
 #include "engine/ecs/components/Components.h"
 
 namespace TerranEngine
@@ -12,11 +13,13 @@ namespace TerranEngine
     public:
         explicit CameraSystem(WindowManager& windowManager) : windowManager(windowManager) {}
 
+        void Bind(World& world);
         void Update(World& world, float deltaTime) override;
 
     private:
         WindowManager& windowManager;
+        Query<Transform2D, Camera2D> cameras;
     };
 }
 
-#endif // TERRANENGINE_CAMERASYSTEM_H
\ No newline at end of file
+#endif // TERRANENGINE_CAMERASYSTEM_H
@@ -0,0 +1,239 @@
+#include "engine/ecs/ChunkStreamer.h"
+
+#include "engine/core/Log.h"
+#include "engine/ecs/world/World.h"
+#include "engine/tiles/TileMapFile.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace TerranEngine
+{
+    static constexpr int CHUNK_TILES = Tilemap::ChunkSize * Tilemap::ChunkSize;
+
+    ChunkStreamer::ChunkStreamer(ThreadPool& pool) : pool(pool) {}
+
+    void ChunkStreamer::Open(glm::ivec2 newChunkCount, Loader newLoader, const Texture* newAtlas, glm::vec2 newTileSize, const glm::vec2& newOrigin)
+    {
+        Close();
+
+        loader     = std::make_shared<const Loader>(std::move(newLoader));
+        chunkCount = glm::max(newChunkCount, glm::ivec2 {0, 0});
+        atlas      = newAtlas;
+        tileSize   = newTileSize;
+        origin     = newOrigin;
+    }
+
+    bool ChunkStreamer::Open(std::string_view filePath, const Texture* newAtlas, glm::vec2 newTileSize, const glm::vec2& newOrigin)
+    {
+        auto file = std::make_shared<TileMapFile>();
+        if (!file->Load(filePath)) { return false; }
+
+        if (!file->LayerCount()) { TE_LOG_ERROR("ChunkStreamer: '{}' has no layers.", filePath); return false; }
+
+        const glm::ivec2 size {static_cast<int>(file->Width()), static_cast<int>(file->Height())};
+
+        // Copies the chunk's rows out of the mapped layer. Page faults on the mapping happen here, on the worker.
+        Loader fileLoader = [file, size](glm::ivec2 chunk, std::vector<uint16_t>& tiles)
+        {
+            const std::span<const uint16_t> layer = file->Layer(0);
+            const glm::ivec2                first = chunk * Tilemap::ChunkSize;
+            const int                       width = std::min(Tilemap::ChunkSize, size.x - first.x);
+
+            for (int y = 0; y < Tilemap::ChunkSize && first.y + y < size.y; ++y)
+            {
+                const size_t source = static_cast<size_t>(first.y + y) * size.x + first.x;
+                std::copy_n(layer.begin() + static_cast<std::ptrdiff_t>(source), width, tiles.begin() + y * Tilemap::ChunkSize);
+            }
+
+            return true;
+        };
+
+        Open((size + Tilemap::ChunkSize - 1) / Tilemap::ChunkSize, std::move(fileLoader), newAtlas, newTileSize, newOrigin);
+        return true;
+    }
+
+    void ChunkStreamer::Close()
+    {
+        // The pool is shared, so queued loads are not cancelled there. They see the new generation and skip themselves instead.
+        inbox->generation.store(++generation, std::memory_order_relaxed);
+
+        {
+            std::lock_guard lock {inbox->mutex};
+            inbox->results.clear();
+        }
+
+        loader.reset();
+        inFlight.clear();
+        ready.clear();
+
+        closing = true; // The World is not available here, so loaded chunks are destroyed by the next Update.
+    }
+
+    void ChunkStreamer::SetRadius(int newLoadRadius, int newUnloadRadius) noexcept
+    {
+        loadRadius   = std::max(newLoadRadius, 0);
+        unloadRadius = std::max(newUnloadRadius, loadRadius);
+    }
+
+    void ChunkStreamer::SetBudget(size_t chunksPerFrame, size_t newMaxInFlight) noexcept
+    {
+        integrateBudget = std::max<size_t>(chunksPerFrame, 1);
+        maxInFlight     = std::max<size_t>(newMaxInFlight, 1);
+    }
+
+    void ChunkStreamer::Bind(World& world) { world.BindQuery(cameras); }
+
+    void ChunkStreamer::Update(World& world, float)
+    {
+        Bind(world);
+
+        if (closing)
+        {
+            Unload(world, {0, 0}, true);
+            closing = false;
+        }
+
+        if (!loader) { return; }
+
+        Camera2D* currentCamera = nullptr;
+        cameras.ForEach([&](Entity, Camera2D& camera)
+        {
+            if (!currentCamera || camera.primary) { currentCamera = &camera; }
+        });
+
+        if (!currentCamera) { return; }
+
+        const glm::vec2  centrePx = (currentCamera->viewMin + currentCamera->viewMax) * 0.5f;
+        const glm::ivec2 centre   = glm::floor((centrePx - origin) / (tileSize * static_cast<float>(Tilemap::ChunkSize)));
+
+        Unload(world, centre, false);
+        Integrate(world, centre);
+        Request(centre);
+    }
+
+    void ChunkStreamer::Unload(World& world, glm::ivec2 centre, bool everything)
+    {
+        const int limit = unloadRadius * unloadRadius;
+
+        for (auto entry = loaded.begin(); entry != loaded.end();)
+        {
+            const glm::ivec2 chunk {static_cast<int32_t>(entry->first >> 32), static_cast<int32_t>(static_cast<uint32_t>(entry->first))};
+            if (!everything && DistanceSquared(chunk, centre) <= limit) { ++entry; continue; }
+
+            // DestroyEntity leaves Components behind, so the chunk's tiles are only freed by removing them.
+            if (const Entity entity = entry->second)
+            {
+                world.RemoveComponent<Tilemap>(entity);
+                world.RemoveComponent<Transform2D>(entity);
+                world.DestroyEntity(entity);
+            }
+
+            entry = loaded.erase(entry);
+        }
+    }
+
+    void ChunkStreamer::Integrate(World& world, glm::ivec2 centre)
+    {
+        {
+            std::lock_guard lock {inbox->mutex};
+            std::move(inbox->results.begin(), inbox->results.end(), std::back_inserter(ready));
+            inbox->results.clear();
+        }
+
+        if (ready.empty()) { return; }
+
+        // Nearest first, since the camera may have moved since these were requested.
+        std::sort(ready.begin(), ready.end(), [centre](const Result& lhs, const Result& rhs) { return DistanceSquared(lhs.chunk, centre) < DistanceSquared(rhs.chunk, centre); });
+
+        const int limit      = unloadRadius * unloadRadius;
+        size_t    integrated = 0;
+        size_t    processed  = 0;
+
+        for (; processed < ready.size() && integrated < integrateBudget; ++processed)
+        {
+            Result& result = ready[processed];
+            if (result.generation != generation) { continue; }
+
+            inFlight.erase(Key(result.chunk));
+
+            // Out of range by the time it finished; it will be requested again if the camera comes back.
+            if (DistanceSquared(result.chunk, centre) > limit) { continue; }
+
+            Entity entity {};
+
+            if (!result.success)
+            {
+                TE_LOG_WARN("ChunkStreamer: Failed to load chunk ({}, {}).", result.chunk.x, result.chunk.y);
+            }
+            else if (std::ranges::any_of(result.tiles, [](uint16_t tile) { return tile != Tilemap::Empty; }))
+            {
+                Tilemap tilemap;
+                tilemap.atlas    = atlas;
+                tilemap.tileSize = tileSize;
+                tilemap.Assign(Tilemap::ChunkSize, Tilemap::ChunkSize, result.tiles);
+
+                entity = world.CreateEntity();
+                world.AddComponent<Transform2D>(entity, Transform2D {origin + glm::vec2(result.chunk) * tileSize * static_cast<float>(Tilemap::ChunkSize)});
+                world.AddComponent<Tilemap>(entity, std::move(tilemap));
+                ++integrated;
+            }
+
+            // Failed chunks are recorded too, so they are not retried every frame.
+            loaded.emplace(Key(result.chunk), entity);
+        }
+
+        ready.erase(ready.begin(), ready.begin() + static_cast<std::ptrdiff_t>(processed));
+    }
+
+    void ChunkStreamer::Request(glm::ivec2 centre)
+    {
+        if (inFlight.size() >= maxInFlight) { return; }
+
+        const int        limit = loadRadius * loadRadius;
+        const glm::ivec2 first = glm::max(centre - loadRadius, glm::ivec2 {0, 0});
+        const glm::ivec2 last  = glm::min(centre + loadRadius, chunkCount - 1);
+
+        candidates.clear();
+
+        for (int y = first.y; y <= last.y; ++y)
+        {
+            for (int x = first.x; x <= last.x; ++x)
+            {
+                const glm::ivec2 chunk {x, y};
+                const uint64_t   key = Key(chunk);
+
+                if (DistanceSquared(chunk, centre) <= limit && !loaded.contains(key) && !inFlight.contains(key)) { candidates.push_back(chunk); }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [centre](glm::ivec2 lhs, glm::ivec2 rhs) { return DistanceSquared(lhs, centre) < DistanceSquared(rhs, centre); });
+
+        for (const glm::ivec2 chunk : candidates)
+        {
+            if (inFlight.size() >= maxInFlight) { break; }
+
+            inFlight.insert(Key(chunk));
+
+            pool.Submit([target = inbox, job = loader, chunk, jobGeneration = generation]
+            {
+                if (target->generation.load(std::memory_order_relaxed) != jobGeneration) { return; }
+
+                Result result {chunk, jobGeneration, false, std::vector<uint16_t>(CHUNK_TILES, Tilemap::Empty)};
+                result.success = (*job)(chunk, result.tiles);
+
+                std::lock_guard lock {target->mutex};
+                target->results.push_back(std::move(result));
+            });
+        }
+    }
+
+    void ChunkStreamer::ReportMemory(MemoryReport& report) const
+    {
+        size_t readyBytes = 0;
+        for (const Result& result : ready) { readyBytes += result.tiles.capacity() * sizeof(uint16_t); }
+
+        report.Add("Streaming/ready",      { readyBytes, readyBytes });
+        report.Add("Streaming/candidates", VectorMemory(candidates));
+    }
+}
@@ -0,0 +1,123 @@
+#ifndef TERRANENGINE_CHUNKSTREAMER_H
+#define TERRANENGINE_CHUNKSTREAMER_H
+
+#include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Components.h"
+#include "engine/core/ThreadPool.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Streams the chunks of a large tile map in and out around the primary `Camera2D`.
+     *
+     * ### Loading.
+     *
+     * The map is split into `Tilemap::ChunkSize` square chunks. Every frame, chunks within `loadRadius` chunks of the camera centre that are neither
+     * loaded nor in flight are requested nearest first, up to `maxInFlight` at a time. Requests run the `Loader` on worker threads, so reading and decoding
+     * never stall the main thread.
+     *
+     * ### Integration.
+     *
+     * Finished chunks are instantiated on the main thread, at most `integrateBudget` per frame, each as an Entity with a `Transform2D` and a chunk-sized `Tilemap`
+     * (drawn by the `TilemapRenderer`). Chunks that are entirely `Tilemap::Empty` are recorded as loaded without creating an Entity.
+     *
+     * ### Unloading.
+     *
+     * Chunks further than `unloadRadius` chunks are destroyed, along with their Components. Keeping `unloadRadius` above `loadRadius` stops chunks on the
+     * boundary from being loaded and unloaded repeatedly as the camera moves back and forth.
+     */
+    class ChunkStreamer final : public System
+    {
+    public:
+        /** Fills `tiles` (`ChunkSize * ChunkSize`, row-major, pre-filled with `Tilemap::Empty`) for `chunk`. Runs on worker threads; must be thread-safe. */
+        using Loader = std::function<bool(glm::ivec2 chunk, std::vector<uint16_t>& tiles)>;
+
+        /** Loads run on `pool`, which is shared with the rest of the engine and must outlive the streamer. */
+        explicit ChunkStreamer(ThreadPool& pool);
+        ~ChunkStreamer() override { Close(); }
+
+        /** Start streaming a map of `chunkCount` chunks, placed with its bottom-left corner at `origin`. Closes any open map first. */
+        void Open(glm::ivec2 chunkCount, Loader loader, const Texture* atlas, glm::vec2 tileSize = {16.0f, 16.0f}, const glm::vec2& origin = {0.0f, 0.0f});
+
+        /** Stream the first layer of a `.tmap` file (see `TileMapFile`). Returns false if it cannot be loaded. */
+        bool Open(std::string_view filePath, const Texture* atlas, glm::vec2 tileSize = {16.0f, 16.0f}, const glm::vec2& origin = {0.0f, 0.0f});
+
+        /** Stop streaming. Loaded chunks are destroyed on the next Update. */
+        void Close();
+
+        void SetRadius(int newLoadRadius, int newUnloadRadius) noexcept;
+        void SetBudget(size_t chunksPerFrame, size_t newMaxInFlight) noexcept;
+
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        [[nodiscard]] size_t LoadedCount()   const noexcept { return loaded.size(); }
+        [[nodiscard]] size_t InFlightCount() const noexcept { return inFlight.size(); }
+
+    private:
+        struct Result
+        {
+            glm::ivec2            chunk;
+            uint32_t              generation;
+            bool                  success;
+            std::vector<uint16_t> tiles;
+        };
+
+        /** Where jobs hand back their results. Shared with them, since a job may still be running on the pool after the streamer is gone. */
+        struct Inbox
+        {
+            std::mutex            mutex;
+            std::vector<Result>   results;        // Written by jobs, drained by Update.
+            std::atomic<uint32_t> generation {0}; // Jobs of an older generation skip their load.
+        };
+
+        [[nodiscard]] static uint64_t Key(glm::ivec2 chunk) noexcept { return (static_cast<uint64_t>(static_cast<uint32_t>(chunk.x)) << 32) | static_cast<uint32_t>(chunk.y); }
+        [[nodiscard]] static int      DistanceSquared(glm::ivec2 a, glm::ivec2 b) noexcept { const glm::ivec2 d = a - b; return d.x * d.x + d.y * d.y; }
+
+        void Unload(World& world, glm::ivec2 centre, bool everything);
+        void Integrate(World& world, glm::ivec2 centre);
+        void Request(glm::ivec2 centre);
+
+    private:
+        // Map being streamed. The Loader is shared with jobs still in flight.
+        std::shared_ptr<const Loader> loader;
+        glm::ivec2                    chunkCount {0, 0};
+        glm::vec2                     origin     {0.0f, 0.0f};
+        glm::vec2                     tileSize   {16.0f, 16.0f};
+        const Texture*                atlas      {nullptr};
+        uint32_t                      generation {0}; // Bumped by Open/Close, so results for an older map are dropped.
+        bool                          closing    {false};
+
+        std::unordered_map<uint64_t, Entity> loaded;     // Null Entity for empty chunks.
+        std::unordered_set<uint64_t>         inFlight;   // Requested, until the result is integrated or dropped.
+        std::vector<glm::ivec2>              candidates;
+        std::vector<Result>                  ready;      // Drained from `results`, waiting for integration budget.
+
+        std::shared_ptr<Inbox> inbox {std::make_shared<Inbox>()};
+
+        int    loadRadius      {4};
+        int    unloadRadius    {6};
+        size_t integrateBudget {2};
+        size_t maxInFlight     {16};
+
+        Query<Camera2D> cameras;
+
+        ThreadPool& pool;
+    };
+}
+
+#endif // TERRANENGINE_CHUNKSTREAMER_H
@@ -0,0 +1,261 @@
+#include "engine/ecs/CollisionSystem.h"
+
+#include "engine/ecs/world/World.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TE_COLLISION_SSE 1
+#else
+    #define TE_COLLISION_SSE 0
+#endif
+
+namespace TerranEngine
+{
+    static bool KeyLess(const CollisionPair& lhs, const CollisionPair& rhs) noexcept { return lhs.Key() < rhs.Key(); }
+
+    void CollisionSystem::Bind(World& world)
+    {
+        world.BindQuery(colliders);
+        world.BindQuery(sprites);
+    }
+
+    void CollisionSystem::Update(World& world, float)
+    {
+        Bind(world);
+
+        GatherBodies(world);
+        SortBodies();
+        Sweep();
+        DiffPairs();
+    }
+
+    void CollisionSystem::GatherBodies(World& world)
+    {
+        ++stamp;
+
+        size_t    visited = 0;
+        size_t    added   = 0;
+        glm::vec2 sum     {0.0f, 0.0f};
+        glm::vec2 sumSq   {0.0f, 0.0f};
+
+        colliders.ForEach([&](Entity entity, Transform2D& transform, Collider2D& collider)
+        {
+            if (!world.IsAlive(entity)) { return; }
+
+            glm::vec2 size   = collider.size;
+            glm::vec2 anchor {0.5f, 0.5f};
+
+            if (size.x == 0.0f && size.y == 0.0f)
+            {
+                if (const Sprite* sprite = sprites.Get<Sprite>(entity))
+                {
+                    size   = sprite->size * transform.scale;
+                    anchor = sprite->anchor;
+                }
+            }
+
+            size = glm::abs(size);
+
+            const glm::vec2 min = transform.position + collider.offset - anchor * size;
+            const Body      body {entity, min, min + size, collider.layer, collider.mask};
+
+            const uint32_t index = entity.Index();
+            if (index >= records.size()) { records.resize(index + 1); }
+
+            // A recycled Index takes over the slot (and sort position) of the Entity it replaced.
+            Record& record = records[index];
+            if (record.slot == Invalid)
+            {
+                record.slot = static_cast<uint32_t>(bodies.size());
+                bodies.push_back(body);
+                ++added;
+            }
+            else
+            {
+                bodies[record.slot] = body;
+            }
+
+            record.entity = entity;
+            record.stamp  = stamp;
+
+            const glm::vec2 centre = min + size * 0.5f;
+            sum   += centre;
+            sumSq += centre * centre;
+            ++visited;
+        });
+
+        // Drop bodies that were not visited, keeping the sorted order of the rest.
+        if (visited != bodies.size())
+        {
+            std::erase_if(bodies, [this](const Body& body)
+            {
+                Record& record = records[body.entity.Index()];
+                if (record.stamp == stamp && record.entity == body.entity) { return false; }
+
+                record.slot = Invalid;
+                return true;
+            });
+        }
+
+        // Sweep along the axis on which the bodies are spread out the most. A small bias stops the axis flipping every frame.
+        int newAxis = axis;
+        if (visited)
+        {
+            const glm::vec2 mean     = sum / static_cast<float>(visited);
+            const glm::vec2 variance = sumSq / static_cast<float>(visited) - mean * mean;
+
+            if (variance[1 - axis] > variance[axis] * 1.25f) { newAxis = 1 - axis; }
+        }
+
+        // Many new bodies (e.g. the first frame) or a new axis make the previous order useless for insertion sort.
+        fullSort = newAxis != axis || added > bodies.size() / 16 + 32;
+        axis     = newAxis;
+    }
+
+    void CollisionSystem::SortBodies()
+    {
+        const int sweepAxis = axis;
+
+        if (fullSort)
+        {
+            std::sort(bodies.begin(), bodies.end(), [sweepAxis](const Body& lhs, const Body& rhs) { return lhs.min[sweepAxis] < rhs.min[sweepAxis]; });
+        }
+        else
+        {
+            // Nearly sorted after a frame of small movements, so this is close to a single linear pass.
+            for (size_t i = 1; i < bodies.size(); ++i)
+            {
+                if (!(bodies[i].min[sweepAxis] < bodies[i - 1].min[sweepAxis])) { continue; }
+
+                const Body body = bodies[i];
+                size_t     j    = i;
+
+                while (j > 0 && bodies[j - 1].min[sweepAxis] > body.min[sweepAxis])
+                {
+                    bodies[j] = bodies[j - 1];
+                    --j;
+                }
+
+                bodies[j] = body;
+            }
+        }
+
+        for (size_t i = 0; i < bodies.size(); ++i) { records[bodies[i].entity.Index()].slot = static_cast<uint32_t>(i); }
+    }
+
+    void CollisionSystem::Sweep()
+    {
+        const int    sweepAxis = axis;
+        const int    crossAxis = 1 - axis;
+        const size_t count     = bodies.size();
+
+        pairs.clear();
+
+        // The lower sweep bounds are padded with +infinity, which ends every inner loop without a bounds check and lets it read whole groups of four.
+        sweepMin.assign(count + SweepPadding, std::numeric_limits<float>::infinity());
+        sweepMax.resize(count);
+        crossMin.assign(count + SweepPadding, 0.0f);
+        crossMax.assign(count + SweepPadding, 0.0f);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            sweepMin[i] = bodies[i].min[sweepAxis];
+            sweepMax[i] = bodies[i].max[sweepAxis];
+            crossMin[i] = bodies[i].min[crossAxis];
+            crossMax[i] = bodies[i].max[crossAxis];
+        }
+
+        // Runs start at multiples of a chunk size of at least `SweepChunk`, so `begin / SweepChunk` gives every run its own list.
+        const size_t rangeCount = (count + SweepChunk - 1) / SweepChunk;
+        if (rangePairs.size() < rangeCount) { rangePairs.resize(rangeCount); }
+        for (std::vector<CollisionPair>& range : rangePairs) { range.clear(); }
+
+        workers.ParallelFor(count, SweepChunk, [this](size_t begin, size_t end) { SweepRange(begin, end, rangePairs[begin / SweepChunk]); });
+
+        for (const std::vector<CollisionPair>& range : rangePairs) { pairs.insert(pairs.end(), range.begin(), range.end()); }
+
+        std::sort(pairs.begin(), pairs.end(), KeyLess);
+    }
+
+    void CollisionSystem::SweepRange(size_t begin, size_t end, std::vector<CollisionPair>& out) const
+    {
+        // Touching edges do not count as overlapping, so neighbouring tiles do not pair up.
+        for (size_t i = begin; i < end; ++i)
+        {
+#if TE_COLLISION_SSE
+            const __m128 aSweepMax = _mm_set1_ps(sweepMax[i]);
+            const __m128 aCrossMin = _mm_set1_ps(crossMin[i]);
+            const __m128 aCrossMax = _mm_set1_ps(crossMax[i]);
+
+            for (size_t j = i + 1; ; j += 4)
+            {
+                // Lower bounds are sorted, so the bodies still inside the sweep range are always a prefix of the group.
+                const int inSweep = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(&sweepMin[j]), aSweepMax));
+                const int inCross = _mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(&crossMax[j]), aCrossMin), _mm_cmplt_ps(_mm_loadu_ps(&crossMin[j]), aCrossMax)));
+
+                for (unsigned hits = static_cast<unsigned>(inSweep & inCross); hits; hits &= hits - 1)
+                {
+                    AddPair(i, j + static_cast<size_t>(std::countr_zero(hits)), out);
+                }
+
+                if (inSweep != 0xF) { break; }
+            }
+#else
+            const float aSweepMax = sweepMax[i];
+            const float aCrossMin = crossMin[i];
+            const float aCrossMax = crossMax[i];
+
+            for (size_t j = i + 1; sweepMin[j] < aSweepMax; ++j)
+            {
+                if (crossMax[j] > aCrossMin && crossMin[j] < aCrossMax) { AddPair(i, j, out); }
+            }
+#endif
+        }
+    }
+
+    void CollisionSystem::AddPair(size_t i, size_t j, std::vector<CollisionPair>& out) const
+    {
+        const Body& lhs = bodies[i];
+        const Body& rhs = bodies[j];
+
+        if (!(lhs.layer & rhs.mask) || !(rhs.layer & lhs.mask)) { return; }
+
+        if (lhs.entity.Raw() < rhs.entity.Raw()) { out.push_back({lhs.entity, rhs.entity}); }
+        else                                     { out.push_back({rhs.entity, lhs.entity}); }
+    }
+
+    void CollisionSystem::DiffPairs()
+    {
+        began.clear();
+        ended.clear();
+
+        std::set_difference(pairs.begin(), pairs.end(), previousPairs.begin(), previousPairs.end(), std::back_inserter(began), KeyLess);
+        std::set_difference(previousPairs.begin(), previousPairs.end(), pairs.begin(), pairs.end(), std::back_inserter(ended), KeyLess);
+
+        previousPairs.assign(pairs.begin(), pairs.end());
+    }
+
+    void CollisionSystem::ReportMemory(MemoryReport& report) const
+    {
+        MemoryUsage sweepMemory = VectorMemory(sweepMin);
+        sweepMemory += VectorMemory(sweepMax);
+        sweepMemory += VectorMemory(crossMin);
+        sweepMemory += VectorMemory(crossMax);
+
+        MemoryUsage pairMemory = VectorMemory(pairs);
+        for (const std::vector<CollisionPair>& range : rangePairs) { pairMemory += VectorMemory(range); }
+        pairMemory += VectorMemory(previousPairs);
+        pairMemory += VectorMemory(began);
+        pairMemory += VectorMemory(ended);
+
+        report.Add("Collision/bodies",  VectorMemory(bodies));
+        report.Add("Collision/records", VectorMemory(records));
+        report.Add("Collision/sweep",   sweepMemory);
+        report.Add("Collision/pairs",   pairMemory);
+    }
+}
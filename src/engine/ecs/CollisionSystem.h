@@ -0,0 +1,115 @@
+#ifndef TERRANENGINE_COLLISIONSYSTEM_H
+#define TERRANENGINE_COLLISIONSYSTEM_H
+
+#include "engine/core/ThreadPool.h"
+#include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Components.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TerranEngine
+{
+    /** Two overlapping colliders, ordered so that `a.Raw() < b.Raw()`. */
+    struct CollisionPair
+    {
+        Entity a;
+        Entity b;
+
+        [[nodiscard]] uint64_t Key() const noexcept { return (static_cast<uint64_t>(a.Raw()) << 32) | b.Raw(); }
+        [[nodiscard]] bool operator==(const CollisionPair& other) const noexcept { return a == other.a && b == other.b; }
+    };
+
+    /**
+     * @brief Sweep-and-prune broadphase over every Entity with a `Transform2D` and a `Collider2D`.
+     *
+     * ### Temporal Coherence.
+     *
+     * Bodies are kept sorted by the lower bound of their box on the sweep axis, and that order is kept between frames.
+     * As bodies only move slightly per frame, re-sorting with insertion sort is close to linear. The sweep then only compares
+     * each body against the following bodies that start before it ends on the sweep axis.
+     *
+     * The sweep axis is the one with the larger spread of box centres, re-chosen every frame. Changing axis falls back to a full sort once.
+     *
+     * The sweep is split over the engine's `ThreadPool`: each run of bodies collects its pairs into its own list, and the lists are joined
+     * before the pairs are sorted, so the result does not depend on how the work was split.
+     *
+     * ### Pair Output.
+     *
+     * `Pairs()` holds every overlapping pair as of the last Update, sorted by `CollisionPair::Key()`. `Began()` and `Ended()` hold the
+     * pairs that started or stopped overlapping in that Update. Systems read them through `World::GetSystem<CollisionSystem>()`.
+     */
+    class CollisionSystem final : public System
+    {
+    public:
+        explicit CollisionSystem(ThreadPool& workers) : workers(workers) {}
+
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        [[nodiscard]] std::span<const CollisionPair> Pairs()  const noexcept { return pairs; }
+        [[nodiscard]] std::span<const CollisionPair> Began()  const noexcept { return began; }
+        [[nodiscard]] std::span<const CollisionPair> Ended()  const noexcept { return ended; }
+        [[nodiscard]] size_t                         Bodies() const noexcept { return bodies.size(); }
+
+    private:
+        struct Body
+        {
+            Entity    entity;
+            glm::vec2 min;
+            glm::vec2 max;
+            uint32_t  layer;
+            uint32_t  mask;
+        };
+
+        /** Slot of each Entity Index in `bodies`. */
+        struct Record
+        {
+            Entity   entity;
+            uint32_t slot  {Invalid};
+            uint32_t stamp {0};
+        };
+
+        void GatherBodies(World& world);
+        void SortBodies();
+        void Sweep();
+        void SweepRange(size_t begin, size_t end, std::vector<CollisionPair>& out) const;
+        void AddPair(size_t i, size_t j, std::vector<CollisionPair>& out) const;
+        void DiffPairs();
+
+    private:
+        std::vector<Body>   bodies; // Sorted by `min[axis]`.
+        std::vector<Record> records;
+
+        // Boxes projected onto the sweep and cross axes (parallel to `bodies`), split per bound so the sweep can test four at a time.
+        std::vector<float> sweepMin;
+        std::vector<float> sweepMax;
+        std::vector<float> crossMin;
+        std::vector<float> crossMax;
+
+        std::vector<std::vector<CollisionPair>> rangePairs; // Pairs found by each run of the parallel sweep, kept for their capacity.
+        std::vector<CollisionPair>              pairs;
+        std::vector<CollisionPair>              previousPairs;
+        std::vector<CollisionPair>              began;
+        std::vector<CollisionPair>              ended;
+
+        int      axis     {0};
+        bool     fullSort {true};
+        uint32_t stamp    {0};
+
+        Query<Transform2D, Collider2D> colliders;
+        Query<Sprite>                  sprites;
+        ThreadPool&                    workers;
+
+        static constexpr uint32_t Invalid      = 0xFFFFFFFFu;
+        static constexpr size_t   SweepPadding = 4;
+        static constexpr size_t   SweepChunk   = 1024; // Fewest bodies swept per worker job.
+    };
+}
+
+#endif // TERRANENGINE_COLLISIONSYSTEM_H
@@ -2,7 +2,12 @@
 #define TERRANENGINE_COMPONENTPOOL_H
 
 #include "engine/ecs/Entity.h"
+#include "engine/ecs/world/EntityManager.h"
+#include "engine/core/MemoryReport.h"
+#include "engine/core/TypeName.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 namespace TerranEngine
@@ -14,6 +19,8 @@ namespace TerranEngine
         virtual ~IComponentPool() = default;
         virtual void Remove(Entity entity) noexcept = 0;
         virtual bool Has(Entity entity) const noexcept = 0;
+        virtual void RemoveDead(const EntityManager& entities) = 0;
+        virtual void ReportMemory(MemoryReport& report) const = 0;
     };
 
     /**
@@ -74,10 +81,9 @@ namespace TerranEngine
 
         void Remove(Entity entity) noexcept override
         {
-            const uint32_t entityID = IndexOf(entity);
-            const uint32_t denseID  = sparseIndices[entityID];
+            const uint32_t denseID = IndexOf(entity);
 
-            if (denseID == Invalid) { return; }
+            if (denseID == Invalid || denseEntities[denseID] != entity) { return; }
 
             // We don't necessarily need to delete the component explicitly unless it's at the back.
             // Instead, we can just overwrite it with the back component, and delete the duplicate/hanging component.
@@ -92,14 +98,48 @@ namespace TerranEngine
 
             denseData.pop_back();
             denseEntities.pop_back();
-            sparseIndices[entityID] = Invalid;
+            sparseIndices[entity.Index()] = Invalid;
+        }
+
+        /** Drop every Component whose Entity is not alive in `entities`, keeping the rest in order, and point the sparse array at the survivors. */
+        void RemoveDead(const EntityManager& entities) override
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < denseEntities.size(); ++i)
+            {
+                if (!entities.IsAlive(denseEntities[i])) { continue; }
+
+                if (kept != i)
+                {
+                    denseData[kept]     = std::move(denseData[i]);
+                    denseEntities[kept] = denseEntities[i];
+                }
+                ++kept;
+            }
+
+            denseData.erase(denseData.begin() + kept, denseData.end());
+            denseEntities.resize(kept);
+
+            std::fill(sparseIndices.begin(), sparseIndices.end(), Invalid);
+            for (uint32_t i = 0; i < kept; ++i) { sparseIndices[denseEntities[i].Index()] = i; }
         }
 
         [[nodiscard]] bool     Has(Entity entity) const noexcept override  { const uint32_t index = IndexOf(entity); return index != Invalid && denseEntities[index] == entity; }
         [[nodiscard]] const T* Get(Entity entity) const noexcept           { const uint32_t index = IndexOf(entity); return (index == Invalid) ? nullptr : &denseData[index]; }
         [[nodiscard]] T*       Get(Entity entity) noexcept                 { const uint32_t index = IndexOf(entity); return (index == Invalid) ? nullptr : &denseData[index]; }
+        [[nodiscard]] T*       Find(Entity entity) noexcept                { const uint32_t index = IndexOf(entity); return (index != Invalid && denseEntities[index] == entity) ? &denseData[index] : nullptr; } // `Get` with generation check.
         [[nodiscard]] const std::vector<T>& Data() const noexcept          { return denseData; }
         [[nodiscard]] const std::vector<Entity>& Entities() const noexcept { return denseEntities; }
+
+        void ReportMemory(MemoryReport& report) const override
+        {
+            const std::string name = "Pool/" + std::string(TypeName<T>());
+
+            // Only sparse entries that map to a live Component count as used; the rest of the sparse array is padding up to the highest Entity Index.
+            report.Add(name + " dense",    VectorMemory(denseData));
+            report.Add(name + " entities", VectorMemory(denseEntities));
+            report.Add(name + " sparse",   VectorMemory(sparseIndices, denseData.size()));
+        }
     
     private:
         void ResizeToFit(uint32_t index) { if (index >= sparseIndices.size()) { sparseIndices.resize(index + 1u, Invalid); } }
@@ -111,6 +151,8 @@ namespace TerranEngine
         std::vector<uint32_t> sparseIndices;
 
         static constexpr uint32_t Invalid = 0xFFFFFFFFu;
+
+        friend class RollbackBuffer;
     };
 }
 
@@ -0,0 +1,66 @@
+#include "engine/ecs/ParticleSystem.h"
+
+#include "engine/ecs/world/World.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace TerranEngine
+{
+    /** xorshift32, mapped to `[0, 1)`. */
+    static float NextRandom(uint32_t& state) noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    void ParticleSystem::Bind(World& world) { world.BindQuery(emitters); }
+
+    void ParticleSystem::Update(World& world, float deltaTime)
+    {
+        Bind(world);
+
+        particleCount = 0;
+        memory        = {};
+
+        emitters.ForEach([&](Entity entity, Transform2D& transform, ParticleEmitter& emitter)
+        {
+            if (!world.IsAlive(entity)) { return; }
+
+            // Simulate first, so fresh particles are drawn at their spawn position.
+            emitter.particles.Simulate(deltaTime, emitter.acceleration);
+            Spawn(emitter, transform.position, deltaTime);
+
+            particleCount += emitter.particles.Count();
+            memory        += emitter.particles.Memory();
+        });
+    }
+
+    void ParticleSystem::Spawn(ParticleEmitter& emitter, const glm::vec2& position, float deltaTime)
+    {
+        if (!emitter.emitting || emitter.rate <= 0.0f) { emitter.spawnDebt = 0.0f; return; }
+
+        emitter.spawnDebt += emitter.rate * deltaTime;
+
+        const float  whole = std::floor(emitter.spawnDebt);
+        const size_t room  = emitter.maxParticles > emitter.particles.Count() ? emitter.maxParticles - emitter.particles.Count() : 0;
+        const size_t count = std::min(static_cast<size_t>(whole), room);
+
+        emitter.spawnDebt -= whole;
+        if (!emitter.seed) { emitter.seed = 0x9E3779B9u; }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float angle    = emitter.direction + (NextRandom(emitter.seed) - 0.5f) * emitter.spread;
+            const float speed    = emitter.speedMin + (emitter.speedMax - emitter.speedMin) * NextRandom(emitter.seed);
+            const float lifetime = emitter.lifetimeMin + (emitter.lifetimeMax - emitter.lifetimeMin) * NextRandom(emitter.seed);
+
+            emitter.particles.Spawn(position, glm::vec2 {std::cos(angle), std::sin(angle)} * speed, lifetime, emitter.maxParticles);
+        }
+    }
+
+    void ParticleSystem::ReportMemory(MemoryReport& report) const { report.Add("Particles/arrays", memory); }
+}
@@ -0,0 +1,37 @@
+#ifndef TERRANENGINE_PARTICLESYSTEM_H
+#define TERRANENGINE_PARTICLESYSTEM_H
+
+#include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Components.h"
+
+namespace TerranEngine
+{
+    /**
+     * @brief Spawns and simulates the particles of every Entity with a `Transform2D` and a `ParticleEmitter`.
+     *
+     * Particles are plain data inside each emitter's `ParticleBuffer`, so simulating them never touches the Component Pools.
+     * Drawing is left to the `SpriteRenderer`, which writes the quads of every emitter straight into its texture's batch.
+     */
+    class ParticleSystem final : public System
+    {
+    public:
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        /** Live particles over every emitter after the last Update. */
+        [[nodiscard]] size_t ParticleCount() const noexcept { return particleCount; }
+
+    private:
+        void Spawn(ParticleEmitter& emitter, const glm::vec2& position, float deltaTime);
+
+    private:
+        Query<Transform2D, ParticleEmitter> emitters;
+
+        size_t      particleCount {0};
+        MemoryUsage memory        {}; // Gathered during Update, as the particle arrays live inside the Components.
+    };
+}
+
+#endif // TERRANENGINE_PARTICLESYSTEM_H
@@ -2,14 +2,35 @@
 
 #include "engine/ecs/world/World.h"
 #include "engine/ecs/Behaviour.h"
-#include "engine/core/Time.h"
 
 namespace TerranEngine
 {
+    void ScriptSystem::Bind(World& world) { world.BindQuery(scripts); }
+
     void ScriptSystem::Update(World& world, float deltaTime)
+    {
+        Bind(world);
+
+        // 1. Awake() and Start(), for Behaviours added since the last fixed tick.
+        StartPending(world, scripts);
+
+        // 2. Update()
+        scripts.ForEach([&world, deltaTime](Entity entity, BehaviourComponent& component)
+        {
+            if (!world.IsAlive(entity)) return;
+
+            Behaviour* script = component.behaviour.get();
+            if (script->started)
+            {
+                script->Update(deltaTime);
+            }
+        });
+    }
+
+    void ScriptSystem::StartPending(World& world, Query<BehaviourComponent>& scripts)
     {
         // 1. Awake()
-        world.ForEach<BehaviourComponent>([&world](Entity entity, BehaviourComponent& component)
+        scripts.ForEach([&world](Entity entity, BehaviourComponent& component)
         {
             if (!world.IsAlive(entity)) return;
 
@@ -24,7 +45,7 @@ namespace TerranEngine
         });
 
         // 2. Start()
-        world.ForEach<BehaviourComponent>([&world](Entity entity, BehaviourComponent& component)
+        scripts.ForEach([&world](Entity entity, BehaviourComponent& component)
         {
             if (!world.IsAlive(entity)) return;
 
@@ -35,34 +56,26 @@ namespace TerranEngine
                 script->started = true;
             }
         });
+    }
 
-        // 3. FixedUpdate()
-        int fixedSteps = Time::ConsumeFixedTicks();
-        float fixedDelta = Time::FixedDeltaTime();
+    void FixedScriptSystem::Bind(World& world) { world.BindQuery(scripts); }
 
-        for (int i = 0; i < fixedSteps; ++i)
-        {
-            world.ForEach<BehaviourComponent>([&world, fixedDelta](Entity entity, BehaviourComponent& component)
-            {
-                if (!world.IsAlive(entity)) return;
+    void FixedScriptSystem::Update(World& world, float fixedDeltaTime)
+    {
+        Bind(world);
 
-                Behaviour* script = component.behaviour.get();
-                if (script->started)
-                {
-                    script->FixedUpdate(fixedDelta);
-                }
-            });
-        }
+        // The fixed phase runs before `ScriptSystem`, so Behaviours added since the last frame are started here first.
+        ScriptSystem::StartPending(world, scripts);
 
-        // 4. Update()
-        world.ForEach<BehaviourComponent>([&world, deltaTime](Entity entity, BehaviourComponent& component)
+        // Runs once per pending fixed tick.
+        scripts.ForEach([&world, fixedDeltaTime](Entity entity, BehaviourComponent& component)
         {
             if (!world.IsAlive(entity)) return;
 
             Behaviour* script = component.behaviour.get();
             if (script->started)
             {
-                script->Update(deltaTime);
+                script->FixedUpdate(fixedDeltaTime);
             }
         });
     }
@@ -2,17 +2,43 @@
 #define TERRANENGINE_SCRIPTSYSTEM_H
 
 #include "engine/ecs/System.h"
+#include "engine/ecs/Behaviour.h"
+#include "engine/ecs/world/Query.h"
 
 namespace TerranEngine
 {
+    /**
+     * Runs Awake(), Start() and Update() on every Behaviour.
+     *
+     * A frame calls each Behaviour's hooks in the same order as a single combined pass would:
+     * Awake() and Start() for new Behaviours, then FixedUpdate() once per pending fixed tick (`FixedScriptSystem`), then Update().
+     * `FixedScriptSystem` runs `StartPending` itself before each fixed tick, as the fixed phase is scheduled before this one.
+     */
     class ScriptSystem : public System
     {
     public:
         ScriptSystem() = default;
         ~ScriptSystem() = default;
 
+        void Bind(World& world);
         void Update(World& world, float deltaTime) override;
-    
+
+        /** Awake() every Behaviour of `scripts` not yet awake, then Start() every one not yet started. */
+        static void StartPending(World& world, Query<BehaviourComponent>& scripts);
+
+    private:
+        Query<BehaviourComponent> scripts;
+    };
+
+    /** Runs FixedUpdate() on every Behaviour, starting new ones first. Registered in `SystemPhase::FIXEDUPDATE`. */
+    class FixedScriptSystem final : public System
+    {
+    public:
+        void Bind(World& world);
+        void Update(World& world, float fixedDeltaTime) override;
+
+    private:
+        Query<BehaviourComponent> scripts;
     };
 }
 
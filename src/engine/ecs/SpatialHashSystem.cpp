@@ -0,0 +1,222 @@
+#include "engine/ecs/SpatialHashSystem.h"
+
+#include "engine/ecs/world/World.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace TerranEngine
+{
+    SpatialHashSystem::SpatialHashSystem(int cellTiles, int tilePx) noexcept : cellPx(std::max(cellTiles, 1) * std::max(tilePx, 1)) {}
+
+    void SpatialHashSystem::Bind(World& world) { world.BindQuery(proxies); }
+
+    void SpatialHashSystem::Update(World& world, float)
+    {
+        Bind(world);
+
+        ++stamp;
+        size_t     visited     = 0;
+        float      frameRadius = 0.0f;
+        glm::ivec2 frameMin {INT_MAX, INT_MAX};
+        glm::ivec2 frameMax {INT_MIN, INT_MIN};
+
+        proxies.ForEach([&](Entity entity, Transform2D& transform, SpatialProxy& proxy)
+        {
+            const uint32_t index = entity.Index();
+            if (index >= records.size()) { records.resize(index + 1); }
+
+            Record&          record     = records[index];
+            const glm::ivec2 coordinate = WorldToGrid(transform.position, cellPx);
+
+            // The Index was recycled, or the Entity moved to another cell.
+            if (record.cell && (record.entity != entity || record.cell->coordinate != coordinate)) { Erase(record); }
+
+            if (record.cell)
+            {
+                Item& item    = record.cell->items[record.slot];
+                item.position = transform.position;
+                item.radius   = proxy.radius;
+            }
+            else
+            {
+                Insert(record, entity, coordinate, transform.position, proxy.radius);
+            }
+
+            record.stamp = stamp;
+            frameRadius  = std::max(frameRadius, proxy.radius);
+            frameMin     = glm::min(frameMin, coordinate);
+            frameMax     = glm::max(frameMax, coordinate);
+            ++visited;
+        });
+
+        // Entities that were not visited have lost their proxy or been destroyed.
+        if (visited != indexedCount)
+        {
+            for (Record& record : records)
+            {
+                if (record.cell && record.stamp != stamp) { Erase(record); }
+            }
+        }
+
+        if (cells.size() - occupiedCells > occupiedCells + 64)
+        {
+            std::erase_if(cells, [](const auto& entry) { return entry.second.items.empty(); });
+        }
+
+        maxRadius = frameRadius;
+        boundsMin = visited ? frameMin : glm::ivec2 {0, 0};
+        boundsMax = visited ? frameMax : glm::ivec2 {0, 0};
+    }
+
+    void SpatialHashSystem::Insert(Record& record, Entity entity, const glm::ivec2& coordinate, const glm::vec2& position, float radius)
+    {
+        Cell& cell = cells.try_emplace(KeyOf(coordinate)).first->second;
+        cell.coordinate = coordinate;
+
+        if (cell.items.empty()) { ++occupiedCells; }
+
+        record.entity = entity;
+        record.cell   = &cell;
+        record.slot   = static_cast<uint32_t>(cell.items.size());
+
+        cell.items.push_back({entity, position, radius});
+        ++indexedCount;
+    }
+
+    void SpatialHashSystem::Erase(Record& record) noexcept
+    {
+        std::vector<Item>& items = record.cell->items;
+
+        // Swap-remove, and repoint the record of the item that filled the gap.
+        if (record.slot != items.size() - 1)
+        {
+            items[record.slot] = items.back();
+            records[items[record.slot].entity.Index()].slot = record.slot;
+        }
+
+        items.pop_back();
+        if (items.empty()) { --occupiedCells; }
+
+        record.cell = nullptr;
+        --indexedCount;
+    }
+
+    size_t SpatialHashSystem::QueryAABB(const glm::vec2& min, const glm::vec2& max, std::span<Entity> out) const
+    {
+        size_t count = 0;
+        if (out.empty()) { return count; }
+
+        ForEachInAABB(min, max, [&](Entity entity, const glm::vec2&)
+        {
+            out[count++] = entity;
+            return count < out.size();
+        });
+
+        return count;
+    }
+
+    size_t SpatialHashSystem::QueryRadius(const glm::vec2& centre, float radius, std::span<Entity> out) const
+    {
+        size_t count = 0;
+        if (out.empty()) { return count; }
+
+        ForEachInRadius(centre, radius, [&](Entity entity, const glm::vec2&)
+        {
+            out[count++] = entity;
+            return count < out.size();
+        });
+
+        return count;
+    }
+
+    size_t SpatialHashSystem::QueryNearest(const glm::vec2& centre, std::span<Entity> out, float maxDistance) const
+    {
+        if (out.empty() || !indexedCount || !(maxDistance >= 0.0f)) { return 0; }
+
+        const auto distanceSquared = [&](Entity entity)
+        {
+            const Record&   record = records[entity.Index()];
+            const glm::vec2 offset = record.cell->items[record.slot].position - centre;
+            return glm::dot(offset, offset);
+        };
+
+        // out[0, count) is kept as a max-heap on distance, so out[0] is always the worst candidate.
+        const auto closer = [&](Entity a, Entity b) { return distanceSquared(a) < distanceSquared(b); };
+
+        const float maxDistanceSquared = maxDistance * maxDistance;
+        size_t count = 0;
+
+        const auto visitCell = [&](int x, int y)
+        {
+            const auto found = cells.find(KeyOf({x, y}));
+            if (found == cells.end()) { return; }
+
+            for (const Item& item : found->second.items)
+            {
+                const glm::vec2 offset   = item.position - centre;
+                const float     distance = glm::dot(offset, offset);
+
+                if (distance > maxDistanceSquared) { continue; }
+
+                if (count < out.size())
+                {
+                    out[count++] = item.entity;
+                    std::push_heap(out.begin(), out.begin() + count, closer);
+                }
+                else if (distance < distanceSquared(out[0]))
+                {
+                    std::pop_heap(out.begin(), out.begin() + count, closer);
+                    out[count - 1] = item.entity;
+                    std::push_heap(out.begin(), out.begin() + count, closer);
+                }
+            }
+        };
+
+        // Search square rings of cells outwards from the centre cell, starting at the first ring that reaches the occupied range.
+        const glm::ivec2 origin    = ClampedCell(centre);
+        const glm::ivec2 toMin     = origin - boundsMin;
+        const glm::ivec2 toMax     = boundsMax - origin;
+        const int        lastRing  = std::max(std::max(toMin.x, toMin.y), std::max(toMax.x, toMax.y));
+        const float      cellWidth = static_cast<float>(cellPx);
+
+        for (int ring = 0; ring <= lastRing; ++ring)
+        {
+            // Every cell of this ring is at least (ring - 1) cells away from the centre.
+            const float ringDistance = std::max(ring - 1, 0) * cellWidth;
+            if (ringDistance * ringDistance > maxDistanceSquared) { break; }
+            if (count == out.size() && distanceSquared(out[0]) <= ringDistance * ringDistance) { break; }
+
+            const int minX = std::max(origin.x - ring, boundsMin.x), maxX = std::min(origin.x + ring, boundsMax.x);
+            const int minY = std::max(origin.y - ring, boundsMin.y), maxY = std::min(origin.y + ring, boundsMax.y);
+
+            if (ring == 0) { visitCell(origin.x, origin.y); continue; }
+
+            if (origin.y - ring >= boundsMin.y) { for (int x = minX; x <= maxX; ++x) { visitCell(x, origin.y - ring); } }
+            if (origin.y + ring <= boundsMax.y) { for (int x = minX; x <= maxX; ++x) { visitCell(x, origin.y + ring); } }
+
+            const int innerMinY = std::max(origin.y - ring + 1, minY);
+            const int innerMaxY = std::min(origin.y + ring - 1, maxY);
+
+            if (origin.x - ring >= boundsMin.x) { for (int y = innerMinY; y <= innerMaxY; ++y) { visitCell(origin.x - ring, y); } }
+            if (origin.x + ring <= boundsMax.x) { for (int y = innerMinY; y <= innerMaxY; ++y) { visitCell(origin.x + ring, y); } }
+        }
+
+        std::sort_heap(out.begin(), out.begin() + count, closer);
+        return count;
+    }
+
+    void SpatialHashSystem::ReportMemory(MemoryReport& report) const
+    {
+        MemoryUsage items;
+        for (const auto& [key, cell] : cells) { items += VectorMemory(cell.items); }
+
+        const size_t nodeBytes   = cells.size() * (sizeof(std::pair<const uint64_t, Cell>) + sizeof(void*));
+        const size_t bucketBytes = cells.bucket_count() * sizeof(void*);
+
+        report.Add("SpatialHash/items",   items);
+        report.Add("SpatialHash/cells",   { occupiedCells * sizeof(Cell), nodeBytes + bucketBytes });
+        report.Add("SpatialHash/records", VectorMemory(records));
+    }
+}
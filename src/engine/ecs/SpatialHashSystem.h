@@ -0,0 +1,191 @@
+#ifndef TERRANENGINE_SPATIALHASHSYSTEM_H
+#define TERRANENGINE_SPATIALHASHSYSTEM_H
+
+#include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Components.h"
+#include "engine/math/Grid.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Uniform-grid spatial index over every Entity with a `Transform2D` and a `SpatialProxy`.
+     *
+     * ### Cell Storage.
+     *
+     * World space is split into square cells of `cellTiles` tiles (using the `WorldToGrid` conventions of `engine/math/Grid.h`), stored sparsely in a hash map.
+     * Each cell holds a packed array of `{Entity, position, radius}` items, so a query reads contiguous memory and never touches the Component Pools.
+     *
+     * ### Incremental Maintenance.
+     *
+     * `Update` walks the proxies once. An Entity that stays in its cell only has its item rewritten in place; one that crosses a cell boundary is swap-removed
+     * from its old cell and appended to the new one. Entities that lost their proxy (or were destroyed) are swept only when the visited count differs from the indexed count.
+     * Emptied cells are kept (so border crossings do not reallocate) and pruned once they outnumber occupied cells.
+     *
+     * ### Queries.
+     *
+     * Queries never allocate: they either write into a caller-provided span (stopping once it is full) or call a visitor.
+     * A visitor receives `(Entity, const glm::vec2& position)` and may return `bool`, where `false` stops the query.
+     * Results describe the state as of the last `Update`, which runs in `SystemPhase::POSTUPDATE`.
+     */
+    class SpatialHashSystem final : public System
+    {
+    public:
+        static constexpr int DefaultCellTiles = 4;
+
+        explicit SpatialHashSystem(int cellTiles = DefaultCellTiles, int tilePx = 16) noexcept;
+
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        /** Entities whose proxy overlaps the rectangle `[min, max]`. Returns the number written to `out`. */
+        size_t QueryAABB(const glm::vec2& min, const glm::vec2& max, std::span<Entity> out) const;
+
+        /** Entities whose proxy overlaps the circle at `centre`. Returns the number written to `out`. */
+        size_t QueryRadius(const glm::vec2& centre, float radius, std::span<Entity> out) const;
+
+        /** Up to `out.size()` Entities closest to `centre` (by position), nearest first, no further than `maxDistance`. Returns the number written to `out`. */
+        size_t QueryNearest(const glm::vec2& centre, std::span<Entity> out, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+        template<typename Visitor>
+        void ForEachInAABB(const glm::vec2& min, const glm::vec2& max, Visitor&& visitor) const
+        {
+            ForEachCell(min - maxRadius, max + maxRadius, [&](const Cell& cell)
+            {
+                for (const Item& item : cell.items)
+                {
+                    const glm::vec2 closest = glm::clamp(item.position, min, max);
+                    const glm::vec2 offset  = item.position - closest;
+
+                    if (glm::dot(offset, offset) <= item.radius * item.radius && !Visit(visitor, item)) { return false; }
+                }
+
+                return true;
+            });
+        }
+
+        template<typename Visitor>
+        void ForEachInRadius(const glm::vec2& centre, float radius, Visitor&& visitor) const
+        {
+            ForEachCell(centre - (radius + maxRadius), centre + (radius + maxRadius), [&](const Cell& cell)
+            {
+                for (const Item& item : cell.items)
+                {
+                    const glm::vec2 offset = item.position - centre;
+                    const float     reach  = radius + item.radius;
+
+                    if (glm::dot(offset, offset) <= reach * reach && !Visit(visitor, item)) { return false; }
+                }
+
+                return true;
+            });
+        }
+
+        [[nodiscard]] size_t Count()    const noexcept { return indexedCount; }
+        [[nodiscard]] int    CellSize() const noexcept { return cellPx; }
+
+    private:
+        struct Item
+        {
+            Entity    entity;
+            glm::vec2 position;
+            float     radius;
+        };
+
+        struct Cell
+        {
+            glm::ivec2        coordinate;
+            std::vector<Item> items;
+        };
+
+        /** Where an Entity Index currently lives. Cell pointers are stable, as `unordered_map` never moves its nodes. */
+        struct Record
+        {
+            Entity   entity;
+            Cell*    cell  {nullptr};
+            uint32_t slot  {0};
+            uint32_t stamp {0};
+        };
+
+        [[nodiscard]] static uint64_t KeyOf(const glm::ivec2& coordinate) noexcept
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(coordinate.x)) << 32) | static_cast<uint32_t>(coordinate.y);
+        }
+
+        template<typename Visitor>
+        static bool Visit(Visitor& visitor, const Item& item)
+        {
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, Entity, const glm::vec2&>, bool>) { return visitor(item.entity, item.position); }
+            else { visitor(item.entity, item.position); return true; }
+        }
+
+        /** Cell coordinate of `position`, clamped to the occupied range so huge or infinite inputs cannot overflow. */
+        [[nodiscard]] glm::ivec2 ClampedCell(const glm::vec2& position) const noexcept
+        {
+            const glm::vec2 lower = GridToWorld(boundsMin, cellPx);
+            const glm::vec2 upper = GridToWorld(boundsMax + 1, cellPx);
+            return glm::clamp(WorldToGrid(glm::clamp(position, lower, upper), cellPx), boundsMin, boundsMax);
+        }
+
+        /** Call `function(const Cell&)` for every occupied cell overlapping `[min, max]`, until it returns false. */
+        template<typename CellFunction>
+        void ForEachCell(const glm::vec2& min, const glm::vec2& max, CellFunction&& function) const
+        {
+            if (!indexedCount || !(min.x <= max.x && min.y <= max.y)) { return; }
+
+            const glm::ivec2 first = ClampedCell(min);
+            const glm::ivec2 last  = ClampedCell(max);
+
+            // A range covering more cells than exist is cheaper to answer by walking the map than by probing it.
+            const size_t rangeCells = static_cast<size_t>(last.x - first.x + 1) * static_cast<size_t>(last.y - first.y + 1);
+            if (rangeCells > cells.size())
+            {
+                for (const auto& [key, cell] : cells)
+                {
+                    const glm::ivec2 c = cell.coordinate;
+                    if (c.x >= first.x && c.x <= last.x && c.y >= first.y && c.y <= last.y && !function(cell)) { return; }
+                }
+                return;
+            }
+
+            for (int y = first.y; y <= last.y; ++y)
+            {
+                for (int x = first.x; x <= last.x; ++x)
+                {
+                    const auto found = cells.find(KeyOf({x, y}));
+                    if (found != cells.end() && !function(found->second)) { return; }
+                }
+            }
+        }
+
+        void Insert(Record& record, Entity entity, const glm::ivec2& coordinate, const glm::vec2& position, float radius);
+        void Erase(Record& record) noexcept;
+
+    private:
+        std::unordered_map<uint64_t, Cell> cells;
+        std::vector<Record>                records; // Indexed by Entity Index.
+
+        glm::ivec2 boundsMin {0, 0}; // Occupied cell range as of the last Update.
+        glm::ivec2 boundsMax {0, 0};
+
+        int      cellPx        {64};
+        float    maxRadius     {0.0f};
+        size_t   indexedCount  {0};
+        size_t   occupiedCells {0};
+        uint32_t stamp         {0};
+
+        Query<Transform2D, SpatialProxy> proxies;
+    };
+}
+
+#endif // TERRANENGINE_SPATIALHASHSYSTEM_H
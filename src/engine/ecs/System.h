@@ -1,6 +1,8 @@
 #ifndef TERRANENGINE_SYSTEM_H
 #define TERRANENGINE_SYSTEM_H
 
+#include "engine/core/MemoryReport.h"
+
 namespace TerranEngine
 {
     class World;
@@ -11,6 +13,9 @@ namespace TerranEngine
     public:
         virtual ~System() = default;
         virtual void Update(World& world, float deltaTime) = 0;
+
+        /** Append the System's own allocations (caches, GPU buffers...) to `report`. */
+        virtual void ReportMemory(MemoryReport&) const {}
     };
 }
 
@@ -0,0 +1,39 @@
+#include "engine/ecs/VisibilitySystem.h"
+
+#include "engine/ecs/world/World.h"
+#include "engine/math/Grid.h"
+
+#include <algorithm>
+
+namespace TerranEngine
+{
+    VisibilitySystem::VisibilitySystem(int tilePx) noexcept : tilePx(std::max(tilePx, 1)) {}
+
+    void VisibilitySystem::Bind(World& world) { world.BindQuery(viewers); }
+
+    void VisibilitySystem::Update(World& world, float)
+    {
+        Bind(world);
+
+        recomputed = 0;
+
+        viewers.ForEach([&](Entity entity, Transform2D& transform, Viewer& viewer)
+        {
+            if (!world.IsAlive(entity)) { return; }
+
+            const glm::ivec2 tile   = WorldToGrid(transform.position, tilePx);
+            const int        radius = std::max(viewer.radius, 0);
+
+            const bool moved   = viewer.visible.Origin() != tile || viewer.visible.Radius() != radius;
+            const bool changed = !moved && opacity.ChangedSince(tile - radius, tile + radius, viewer.computedAt);
+
+            if (!moved && !changed) { return; }
+
+            fov.Compute(opacity, tile, radius, viewer.visible);
+            viewer.computedAt = opacity.Stamp();
+            ++recomputed;
+        });
+    }
+
+    void VisibilitySystem::ReportMemory(MemoryReport& report) const { opacity.ReportMemory(report); }
+}
@@ -0,0 +1,46 @@
+#ifndef TERRANENGINE_VISIBILITYSYSTEM_H
+#define TERRANENGINE_VISIBILITYSYSTEM_H
+
+#include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Components.h"
+#include "engine/tiles/FieldOfView.h"
+
+namespace TerranEngine
+{
+    /**
+     * @brief Keeps the `Viewer::visible` set of every Entity with a `Transform2D` and a `Viewer` up to date.
+     *
+     * A Viewer's field of view is only recomputed when its tile or radius changed, or when a tile within its radius changed opacity since
+     * it was last computed (checked against the per-chunk stamps of the `OpacityGrid`). Idle viewers in a static map therefore cost one
+     * comparison per frame, so hundreds of them stay cheap.
+     *
+     * The map's opacity is owned here and edited through `Opacity()`, e.g. `Opacity().Assign(map.tiles, isWall)` after loading a map.
+     */
+    class VisibilitySystem final : public System
+    {
+    public:
+        explicit VisibilitySystem(int tilePx = 16) noexcept;
+
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        [[nodiscard]] OpacityGrid&       Opacity()       noexcept { return opacity; }
+        [[nodiscard]] const OpacityGrid& Opacity() const noexcept { return opacity; }
+
+        /** Number of Viewers recomputed by the last Update. */
+        [[nodiscard]] size_t RecomputedCount() const noexcept { return recomputed; }
+
+    private:
+        OpacityGrid opacity;
+        FieldOfView fov;
+
+        int    tilePx     {16};
+        size_t recomputed {0};
+
+        Query<Transform2D, Viewer> viewers;
+    };
+}
+
+#endif // TERRANENGINE_VISIBILITYSYSTEM_H
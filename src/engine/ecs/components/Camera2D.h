@@ -12,6 +12,8 @@ namespace TerranEngine
         int viewportWidth        {320};
         int viewportHeight       {240};
         glm::mat4 viewProjection {1.0f};
+        glm::vec2 viewMin        {0.0f, 0.0f};     // World-space bounds visible through the camera (set by CameraSystem).
+        glm::vec2 viewMax        {320.0f, 240.0f};
 
         bool primary             {true};
     };
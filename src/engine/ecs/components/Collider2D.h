@@ -0,0 +1,19 @@
+#ifndef TERRANENGINE_COLLIDER2D_H
+#define TERRANENGINE_COLLIDER2D_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace TerranEngine
+{
+    struct Collider2D
+    {
+        glm::vec2 size   {0.0f, 0.0f};  // AABB size in pixels. Zero derives it from `Sprite::size * Transform2D::scale` (aligned to the Sprite anchor).
+        glm::vec2 offset {0.0f, 0.0f};  // Offset of the box from the Transform2D position.
+        uint32_t  layer  {1u};          // Layer bits this collider belongs to.
+        uint32_t  mask   {0xFFFFFFFFu}; // Layer bits this collider overlaps with. A pair needs each collider's layer in the other's mask.
+    };
+}
+
+#endif // TERRANENGINE_COLLIDER2D_H
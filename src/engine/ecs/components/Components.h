@@ -2,8 +2,13 @@
 #define TERRANENGINE_COMPONENTS_H
 
 #include "engine/ecs/components/Camera2D.h"
+#include "engine/ecs/components/Collider2D.h"
+#include "engine/ecs/components/ParticleEmitter.h"
 #include "engine/ecs/components/Relationship.h"
+#include "engine/ecs/components/SpatialProxy.h"
 #include "engine/ecs/components/Sprite.h"
+#include "engine/ecs/components/Tilemap.h"
 #include "engine/ecs/components/Transform2D.h"
+#include "engine/ecs/components/Viewer.h"
 
 #endif // TERRANENGINE_COMPONENTS_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef TERRANENGINE_PARTICLEEMITTER_H
+#define TERRANENGINE_PARTICLEEMITTER_H
+
+#include "engine/gfx/BlendMode.h"
+#include "engine/gfx/ParticleBuffer.h"
+#include "engine/gfx/Texture.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace TerranEngine
+{
+    /**
+     * Emits particles from an Entity's `Transform2D` position. Particles live in world space inside `particles` rather than as Entities,
+     * are simulated by the `ParticleSystem` and drawn by the `SpriteRenderer`.
+     */
+    struct ParticleEmitter
+    {
+        const Texture* texture      {nullptr};                // Texture atlas to sample from.
+        glm::vec2      size         {16.0f, 16.0f};           // Atlas tile size in pixels, and the particle size at a scale of 1.
+        uint32_t       atlasIndex   {0};                      // Index of the tile inside the atlas (row-major).
+        int32_t        zLevel       {0};                      // Z-layer shared by every particle.
+        BlendMode      blend        {BlendMode::Alpha};
+
+        float          rate         {100.0f};                 // Particles spawned per second while `emitting`.
+        uint32_t       maxParticles {10000};                  // Spawning pauses while this many particles are alive.
+        bool           emitting     {true};
+
+        float          lifetimeMin  {1.0f};                   // Seconds.
+        float          lifetimeMax  {1.0f};
+        float          speedMin     {0.0f};                   // Pixels per second.
+        float          speedMax     {50.0f};
+        float          direction    {1.5707963f};             // Radians, 0 = +X. Default is straight up.
+        float          spread       {6.2831853f};             // Full cone angle around `direction` in radians.
+        glm::vec2      acceleration {0.0f, 0.0f};             // Constant acceleration, e.g. gravity, in pixels per second squared.
+
+        float          startScale   {1.0f};                   // Size multiplier at birth and at death.
+        float          endScale     {1.0f};
+        glm::vec4      startColour  {1.0f, 1.0f, 1.0f, 1.0f}; // Tint at birth and at death.
+        glm::vec4      endColour    {1.0f, 1.0f, 1.0f, 0.0f};
+
+        ParticleBuffer particles;
+        float          spawnDebt    {0.0f};                   // Fractional particles carried over between frames.
+        uint32_t       seed         {0x9E3779B9u};            // Random state for spawn variation. Must not be 0.
+    };
+}
+
+#endif // TERRANENGINE_PARTICLEEMITTER_H
@@ -0,0 +1,13 @@
+#ifndef TERRANENGINE_SPATIALPROXY_H
+#define TERRANENGINE_SPATIALPROXY_H
+
+namespace TerranEngine
+{
+    /** Opts an Entity with a `Transform2D` into the `SpatialHashSystem` index. */
+    struct SpatialProxy
+    {
+        float radius {0.0f}; // Extent around the Transform2D position considered by range queries (0 = point).
+    };
+}
+
+#endif // TERRANENGINE_SPATIALPROXY_H
@@ -1,6 +1,7 @@
 #ifndef TERRANENGINE_SPRITE_H
 #define TERRANENGINE_SPRITE_H
 
+#include "engine/gfx/BlendMode.h"
 #include "engine/gfx/Texture.h"
 
 #include <glm/glm.hpp>
@@ -16,6 +17,21 @@ namespace TerranEngine
         glm::vec2 anchor       {0.5f, 0.5f};             // Alignment of sprite to world-position. Range 0-1
         glm::vec2 origin       {0.5f, 0.5f};             // Pivot point for rotation and scaling. Range 0-1
         int32_t zLevel         {0};                      // Z-layer of the sprite. 0 = mid-layer.
+        glm::vec4 region       {0.0f, 0.0f, 0.0f, 0.0f}; // UV min and max of a `TextureAtlas` region. Used instead of `atlasIndex` when set.
+        BlendMode blend        {BlendMode::Alpha};
+
+        /** UV rectangle to draw: the atlas region if one is set, otherwise tile `atlasIndex` of a grid of `size` tiles. */
+        void UV(glm::vec2& uvMin, glm::vec2& uvMax) const noexcept
+        {
+            if (region.z > region.x)
+            {
+                uvMin = { region.x, region.y };
+                uvMax = { region.z, region.w };
+                return;
+            }
+
+            texture->TileUV(size, atlasIndex, uvMin, uvMax);
+        }
     };
 }
 
@@ -0,0 +1,85 @@
+#ifndef TERRANENGINE_TILEMAP_H
+#define TERRANENGINE_TILEMAP_H
+
+#include "engine/gfx/Texture.h"
+#include "engine/tiles/TileChunkMap.h"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief A grid of atlas tiles drawn by the `TilemapRenderer`, placed with its bottom-left corner at the Entity's `Transform2D` position.
+     *
+     * Tile `(x, y)` covers `[position + (x, y) * tileSize, position + (x + 1, y + 1) * tileSize]`. Tiles are held in a `TileChunkMap`, whose
+     * `ChunkSize x ChunkSize` chunks are each stamped with a revision whenever one of their tiles changes, so the renderer only rebuilds the chunks
+     * that changed.
+     * Tiles must therefore be edited through `Set` or `Assign`. Revisions come from one counter shared by every Tilemap, so a map replaced by
+     * another on the same Entity never repeats the revisions its meshes were built from.
+     */
+    struct Tilemap
+    {
+        static constexpr int      ChunkSize = TileChunkMap::ChunkSize;
+        static constexpr uint16_t Empty     = 0xFFFF; // Tile ID that is not drawn.
+
+        const Texture* atlas    {nullptr};      // Texture atlas to sample from.
+        glm::vec2      tileSize {16.0f, 16.0f}; // Atlas tile size in pixels, also the size of a tile in the world.
+        int32_t        zLevel   {0};            // Z-layer of every tile.
+        bool           merge    {true};         // Let the renderer draw rectangles of identical tiles as single repeating quads.
+
+        /** Replace every tile with `newTiles` (`newWidth * newHeight`, row-major from the bottom row). Missing tiles are `Empty`. */
+        void Assign(int newWidth, int newHeight, std::span<const uint16_t> newTiles)
+        {
+            tiles.Assign(newWidth, newHeight, newTiles, Empty);
+            chunkRevisions.assign(static_cast<size_t>(tiles.ChunksX()) * tiles.ChunksY(), NextRevision());
+        }
+
+        /** Take over already chunked tiles (e.g. a loaded `Map::tiles`) without expanding them. */
+        void Assign(TileChunkMap newTiles)
+        {
+            tiles = std::move(newTiles);
+            chunkRevisions.assign(static_cast<size_t>(tiles.ChunksX()) * tiles.ChunksY(), NextRevision());
+        }
+
+        void Set(glm::ivec2 tile, uint16_t id)
+        {
+            if (!InBounds(tile) || tiles.Get(tile) == id) { return; }
+
+            tiles.Set(tile, id);
+            chunkRevisions[static_cast<size_t>(tile.y / ChunkSize) * ChunksX() + tile.x / ChunkSize] = NextRevision();
+        }
+
+        [[nodiscard]] uint16_t Get(glm::ivec2 tile) const noexcept { return tiles.Get(tile, Empty); }
+        [[nodiscard]] bool     InBounds(glm::ivec2 tile) const noexcept { return tiles.InBounds(tile); }
+
+        [[nodiscard]] int Width()   const noexcept { return tiles.Width(); }
+        [[nodiscard]] int Height()  const noexcept { return tiles.Height(); }
+        [[nodiscard]] int ChunksX() const noexcept { return tiles.ChunksX(); }
+        [[nodiscard]] int ChunksY() const noexcept { return tiles.ChunksY(); }
+
+        /** Revision of the last change to chunk `(x, y)`. Never 0 once the map has been assigned. */
+        [[nodiscard]] uint32_t ChunkRevision(glm::ivec2 chunk) const noexcept { return chunkRevisions[static_cast<size_t>(chunk.y) * ChunksX() + chunk.x]; }
+
+        /** The tiles themselves, for reading a chunk at a time with `TileChunkMap::ReadChunk` or `IsUniform`. */
+        [[nodiscard]] const TileChunkMap& Tiles() const noexcept { return tiles; }
+
+    private:
+        static uint32_t NextRevision() noexcept
+        {
+            static std::atomic<uint32_t> revision {0};
+            return revision.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+    private:
+        TileChunkMap          tiles;
+        std::vector<uint32_t> chunkRevisions;
+    };
+}
+
+#endif // TERRANENGINE_TILEMAP_H
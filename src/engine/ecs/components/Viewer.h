@@ -0,0 +1,19 @@
+#ifndef TERRANENGINE_VIEWER_H
+#define TERRANENGINE_VIEWER_H
+
+#include "engine/tiles/FieldOfView.h"
+
+#include <cstdint>
+
+namespace TerranEngine
+{
+    /** Gives an Entity with a `Transform2D` a field of view, kept up to date by the `VisibilitySystem`. */
+    struct Viewer
+    {
+        int           radius     {8}; // Sight range in tiles.
+        VisibilitySet visible;        // Tiles visible from the Entity's tile as of the last recompute.
+        uint64_t      computedAt {0}; // `OpacityGrid::Stamp()` when `visible` was computed.
+    };
+}
+
+#endif // TERRANENGINE_VIEWER_H
@@ -75,7 +75,15 @@ namespace TerranEngine
             return (iterator == pools.end()) ? nullptr : static_cast<const ComponentPool<T>*>(iterator->second.get());
         }
 
-        void Reset() { pools.clear(); }
+        void Reset() { pools.clear(); ++epoch; }
+
+        void ReportMemory(MemoryReport& report) const
+        {
+            for (const auto& [typeIndex, pool] : pools) { pool->ReportMemory(report); }
+        }
+
+        /** Incremented on every `Reset()`, invalidating pool pointers cached by Queries. */
+        [[nodiscard]] uint32_t Epoch() const noexcept { return epoch; }
 
     private:
         template<typename T>
@@ -98,6 +106,9 @@ namespace TerranEngine
 
     private:
         std::unordered_map<std::type_index, std::unique_ptr<IComponentPool>> pools;
+        uint32_t epoch {0};
+
+        friend class RollbackBuffer;
     };
 }
 
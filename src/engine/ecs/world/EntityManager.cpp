@@ -4,13 +4,16 @@ namespace TerranEngine
 {
     Entity EntityManager::CreateEntity()
     {
+        if (HasReserved()) { FlushReserved(); }
+
         uint32_t index;
 
         // If there is a free Entity index, take on the index and effectively "pop" the front of the free-queue.
-        if (freeHead != Invalid)
+        if (committedHead != Invalid)
         {
-            index = freeHead;
-            freeHead = slots[index].nextFree;
+            index = committedHead;
+            committedHead = slots[index].nextFree;
+            freeHead.store(committedHead, std::memory_order_relaxed);
         }
         else
         {
@@ -25,8 +28,64 @@ namespace TerranEngine
         return Entity { Entity::CreateEntity(index, generation) };
     }
 
+    Entity EntityManager::ReserveEntity() noexcept
+    {
+        uint32_t index;
+        if (PopFree(index)) { return Entity { Entity::CreateEntity(index, slots[index].generation) }; }
+
+        // Free-list exhausted: claim the next index past the end of the committed slots.
+        index = static_cast<uint32_t>(slots.size()) + reservedCount.fetch_add(1, std::memory_order_relaxed);
+        return Entity { Entity::CreateEntity(index, 0) };
+    }
+
+    void EntityManager::ReserveEntities(Entity* outEntities, uint32_t count) noexcept
+    {
+        uint32_t reserved = 0;
+        uint32_t index;
+
+        while (reserved < count && PopFree(index))
+        {
+            outEntities[reserved++] = Entity { Entity::CreateEntity(index, slots[index].generation) };
+        }
+
+        if (reserved == count) { return; }
+
+        // Claim all remaining fresh indices with one atomic operation.
+        const uint32_t first = static_cast<uint32_t>(slots.size()) + reservedCount.fetch_add(count - reserved, std::memory_order_relaxed);
+        for (uint32_t i = 0; reserved < count; ++i)
+        {
+            outEntities[reserved++] = Entity { Entity::CreateEntity(first + i, 0) };
+        }
+    }
+
+    void EntityManager::FlushReserved()
+    {
+        // Every node popped since the last flush lies between the committed head and the live head.
+        const uint32_t head = freeHead.load(std::memory_order_acquire);
+        uint32_t index = committedHead;
+
+        while (index != head)
+        {
+            Slot& slot = slots[index];
+            index = slot.nextFree;
+            slot.alive = true;
+        }
+
+        committedHead = head;
+
+        // Fresh indices were handed out contiguously from the end of `slots`.
+        const uint32_t fresh = reservedCount.exchange(0, std::memory_order_acq_rel);
+        const size_t   first = slots.size();
+        slots.resize(first + fresh);
+
+        for (size_t i = first; i < slots.size(); ++i) { slots[i].alive = true; }
+    }
+
     void EntityManager::DestroyEntity(Entity entity)
     {
+        // Flushed first, so a reserved Entity that is destroyed before the next sync point is committed and then destroyed, not skipped.
+        if (HasReserved()) { FlushReserved(); }
+
         if (!IsAlive(entity)) return;
 
         const uint32_t index = entity.Index();
@@ -34,8 +93,9 @@ namespace TerranEngine
 
         slot.alive = false;
         slot.generation = (slot.generation + 1u) & GenerationMask;
-        slot.nextFree = freeHead;
-        freeHead = index;
+        slot.nextFree = committedHead;
+        committedHead = index;
+        freeHead.store(committedHead, std::memory_order_relaxed);
     }
 
     bool EntityManager::IsAlive(Entity entity) const noexcept
@@ -50,6 +110,26 @@ namespace TerranEngine
     void EntityManager::Reset()
     {
         slots.clear();
-        freeHead = Invalid;
+        freeHead.store(Invalid, std::memory_order_relaxed);
+        committedHead = Invalid;
+        reservedCount.store(0, std::memory_order_relaxed);
+    }
+
+    bool EntityManager::PopFree(uint32_t& outIndex) noexcept
+    {
+        // Lock-free pop. Pushes only happen on the main thread outside of reservation, so the head cannot be recycled (ABA) mid-loop.
+        uint32_t head = freeHead.load(std::memory_order_acquire);
+
+        while (head != Invalid)
+        {
+            const uint32_t next = slots[head].nextFree;
+            if (freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                outIndex = head;
+                return true;
+            }
+        }
+
+        return false;
     }
-}
\ No newline at end of file
+}
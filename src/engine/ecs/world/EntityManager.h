@@ -2,7 +2,9 @@
 #define TERRANENGINE_ENTITYMANAGER_H
 
 #include "engine/ecs/Entity.h"
+#include "engine/core/MemoryReport.h"
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -16,6 +18,17 @@ namespace TerranEngine
      * A vector of `slots` stores all allocated entities, both live and free.
      * Each Entity `slot` holds a reference to the next free Entity in the array, resulting in an emergent singly-linked list of freed Entities, allowing for easy reuse of free Entity Indexes.
      * Entities are lazy-loaded, and prefer replacement of freed IDs over creating new Entities.
+     *
+     * ### Concurrent Reservation.
+     *
+     * `ReserveEntity()` may be called from any number of threads at once, and hands back a valid Entity handle immediately.
+     * Reserved Entities are not alive until `FlushReserved()` commits them at the next sync point (the `SystemScheduler` flushes after every System).
+     *
+     * - Freed indices are popped from the head of the free-list with a CAS loop. Only pops happen while reserving, so the list cannot suffer ABA.
+     *   Because pops always take the head, the indices reserved since the last flush are exactly the list nodes between `committedHead` and `freeHead`.
+     * - Once the free-list is empty, fresh indices past the end of `slots` are claimed with a single atomic counter (`ReserveEntities()` claims a whole block at once).
+     *
+     * While reservations are in flight, only `ReserveEntity()`, `ReserveEntities()` and `IsAlive()` may be called; `slots` is never resized until the flush.
      */
     class EntityManager
     {
@@ -27,11 +40,24 @@ namespace TerranEngine
 
         [[nodiscard]] Entity CreateEntity();
 
+        /** Thread-safe. Reserve an Entity that becomes alive at the next `FlushReserved()`. */
+        [[nodiscard]] Entity ReserveEntity() noexcept;
+
+        /** Thread-safe. Reserve `count` Entities into `outEntities`, claiming fresh indices as a single block. */
+        void ReserveEntities(Entity* outEntities, uint32_t count) noexcept;
+
+        /** Commit every reserved Entity. Must not run concurrently with reservations. */
+        void FlushReserved();
+
+        [[nodiscard]] bool HasReserved() const noexcept { return committedHead != freeHead.load(std::memory_order_relaxed) || reservedCount.load(std::memory_order_relaxed) != 0; }
+
         void DestroyEntity(Entity entity);
         [[nodiscard]] bool IsAlive(Entity entity) const noexcept;
 
         void Reset();
 
+        void ReportMemory(MemoryReport& report) const { report.Add("Entity/slots", VectorMemory(slots)); }
+
     private:
         struct Slot
         {
@@ -40,11 +66,17 @@ namespace TerranEngine
             bool     alive      {false};
         };
 
-        std::vector<Slot> slots;
-        uint32_t          freeHead {Invalid};
+        [[nodiscard]] bool PopFree(uint32_t& outIndex) noexcept;
+
+        std::vector<Slot>     slots;
+        std::atomic<uint32_t> freeHead      {Invalid};
+        uint32_t              committedHead {Invalid};
+        std::atomic<uint32_t> reservedCount {0};
 
         static constexpr uint32_t Invalid        = 0xFFFFFFFFu;
         static constexpr uint32_t GenerationMask = 0xFFu;
+
+        friend class RollbackBuffer;
     };
 }
 
@@ -1,18 +1,20 @@
 #include "engine/ecs/world/HierarchySystem.h"
 
-#include "engine/ecs/components/Relationship.h"
-#include "engine/ecs/components/Transform2D.h"
 #include "engine/ecs/world/World.h"
 
 namespace TerranEngine
 {
+    void HierarchySystem::Bind(World& world) { world.BindQuery(children); }
+
     void HierarchySystem::Update(World& world, float)
     {
-        world.ForEach<Relationship, Transform2D>([&](Entity, Relationship& relationship, Transform2D& childTransform)
+        Bind(world);
+
+        children.ForEach([this](Entity, Relationship& relationship, Transform2D& childTransform)
         {
             if (!relationship.parent) { return; }
 
-            Transform2D* parentTransform = world.GetComponent<Transform2D>(relationship.parent);
+            Transform2D* parentTransform = children.Get<Transform2D>(relationship.parent);
             if (!parentTransform) { return; } // Check for `nullptr` return.
 
             childTransform.position = parentTransform->position + relationship.transformOffset;
@@ -21,4 +23,4 @@ namespace TerranEngine
             if (relationship.inheritRotation) { childTransform.rotation = parentTransform->rotation; }
         });
     }
-}
\ No newline at end of file
+}
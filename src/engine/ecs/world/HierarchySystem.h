@@ -2,6 +2,9 @@
 #define TERRANENGINE_HIERARCHYSYSTEM_H
 
 #include "engine/ecs/System.h"
+#include "engine/ecs/world/Query.h"
+#include "engine/ecs/components/Relationship.h"
+#include "engine/ecs/components/Transform2D.h"
 
 namespace TerranEngine
 {
@@ -11,8 +14,12 @@ namespace TerranEngine
         HierarchySystem()  = default;
         ~HierarchySystem() = default;
 
-        void Update(World& world, float deltaTime);
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+
+    private:
+        Query<Relationship, Transform2D> children;
     };
 }
 
-#endif // TERRANENGINE_HIERARCHYSYSTEM_H
\ No newline at end of file
+#endif // TERRANENGINE_HIERARCHYSYSTEM_H
@@ -0,0 +1,98 @@
+#ifndef TERRANENGINE_QUERY_H
+#define TERRANENGINE_QUERY_H
+
+#include "engine/ecs/world/ComponentManager.h"
+
+#include <tuple>
+
+namespace TerranEngine
+{
+    /**
+     * @brief A Query caches the Component Pools it iterates, so they are only looked up when it is bound rather than on every call or Entity.
+     *
+     * ### Binding.
+     *
+     * Pool pointers are resolved once by `Bind()`. A Query stays valid across frames, and re-resolves itself when the `ComponentManager` is reset (tracked by its epoch),
+     * or when one of its pools did not exist yet at the time it was bound.
+     *
+     * Systems keep Queries as members and bind them through `World::BindQuery()`, which is a no-op once the Query is bound to that World.
+     */
+    template<typename Lead, typename... Rest>
+    class Query
+    {
+    public:
+        Query() = default;
+        explicit Query(ComponentManager& componentManager) { Bind(componentManager); }
+
+        void Bind(ComponentManager& componentManager) noexcept
+        {
+            components = &componentManager;
+            epoch      = componentManager.Epoch();
+            leadPool   = componentManager.GetPool<Lead>();
+            restPools  = { componentManager.GetPool<Rest>()... };
+        }
+
+        [[nodiscard]] bool IsBoundTo(const ComponentManager& componentManager) const noexcept { return components == &componentManager && epoch == componentManager.Epoch(); }
+
+        /** Function/Lambda `must` parse Entity first, and then non-const references to the components in the same order that they were given in the template list. */
+        template<typename Function>
+        void ForEach(Function&& function)
+        {
+            if (!Resolve()) { return; }
+
+            const auto& dense     = leadPool->Data();
+            const auto& entityIDs = leadPool->Entities();
+
+            for (size_t i = 0; i < dense.size(); ++i)
+            {
+                Entity entity {entityIDs[i]};
+
+                if constexpr (sizeof...(Rest) == 0)
+                {
+                    function(entity, const_cast<Lead&>(dense[i]));
+                }
+                else
+                {
+                    std::apply([&](ComponentPool<Rest>*... pools)
+                    {
+                        // Single sparse lookup per pool; skip the Entity as soon as one Component is missing.
+                        std::tuple<Rest*...> rest {pools->Find(entity)...};
+                        if ((std::get<Rest*>(rest) && ...))
+                        {
+                            function(entity, const_cast<Lead&>(dense[i]), *std::get<Rest*>(rest)...);
+                        }
+                    }, restPools);
+                }
+            }
+        }
+
+        /** Look up any Component type of the Query through its bound pool. */
+        template<typename T>
+        [[nodiscard]] T* Get(Entity entity) noexcept
+        {
+            if (!Resolve()) { return nullptr; }
+
+            if constexpr (std::is_same_v<T, Lead>) { return leadPool->Find(entity); }
+            else                                   { return std::get<ComponentPool<T>*>(restPools)->Find(entity); }
+        }
+
+    private:
+        [[nodiscard]] bool Resolve() noexcept
+        {
+            if (!components) { return false; }
+
+            if (epoch != components->Epoch() || !Resolved()) { Bind(*components); }
+            return Resolved();
+        }
+
+        [[nodiscard]] bool Resolved() const noexcept { return leadPool && ((std::get<ComponentPool<Rest>*>(restPools) != nullptr) && ...); }
+
+    private:
+        ComponentManager*                    components {nullptr};
+        ComponentPool<Lead>*                 leadPool   {nullptr};
+        std::tuple<ComponentPool<Rest>*...>  restPools  {};
+        uint32_t                             epoch      {0};
+    };
+}
+
+#endif // TERRANENGINE_QUERY_H
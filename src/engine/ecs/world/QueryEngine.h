@@ -2,6 +2,7 @@
 #define TERRANENGINE_QUERYENGINE_H
 
 #include "engine/ecs/world/ComponentManager.h"
+#include "engine/ecs/world/Query.h"
 
 namespace TerranEngine
 {
@@ -14,31 +15,15 @@ namespace TerranEngine
         template<typename Lead, typename... Rest, typename Function>
         void ForEach(Function&& function)
         {
-            static_assert((sizeof...(Rest) >= 0), "ForEach needs at least one component type.");
-
-            auto* leadPool = components.GetPool<Lead>();
-            if (!leadPool) { return; }
-
-            const auto& dense     = leadPool->Data();
-            const auto& entityIDs = leadPool->Entities();
-
-            for (size_t i = 0; i < dense.size(); ++i)
-            {
-                Entity entity {entityIDs[i]};
+            // Pools are resolved once per call. Systems that run every frame should hold a bound `Query` instead.
+            Query<Lead, Rest...> query {components};
+            query.ForEach(std::forward<Function>(function));
+        }
 
-                if constexpr (sizeof...(Rest) == 0)
-                {
-                    // Faster way of doing it for single-component cases.
-                    if (components.Has<Lead>(entity)) { function(entity, const_cast<Lead&>(dense[i])); }
-                }
-                else
-                {
-                    if ((components.Has<Rest>(entity) && ...))
-                    {
-                        function(entity, const_cast<Lead&>(dense[i]), *components.Get<Rest>(entity)...);
-                    }
-                }
-            }
+        template<typename... Components>
+        void Bind(Query<Components...>& query)
+        {
+            if (!query.IsBoundTo(components)) { query.Bind(components); }
         }
 
     private:
@@ -46,4 +31,4 @@ namespace TerranEngine
     };
 }
 
-#endif // TERRANENGINE_QUERYENGINE_H
\ No newline at end of file
+#endif // TERRANENGINE_QUERYENGINE_H
@@ -0,0 +1,168 @@
+#include "engine/ecs/world/RollbackBuffer.h"
+
+#include "engine/core/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace TerranEngine
+{
+    void PagedSnapshot::Capture(const void* data, size_t byteCount, const PagedSnapshot& previous, PagePool& freePages)
+    {
+        const std::byte* source    = static_cast<const std::byte*>(data);
+        const size_t     pageCount = (byteCount + PageSize - 1) / PageSize;
+
+        // Build the new page list before releasing the old one, as `previous` may be this snapshot (single-slot ring).
+        std::vector<std::shared_ptr<Page>> captured(pageCount);
+
+        for (size_t i = 0; i < pageCount; ++i)
+        {
+            const size_t offset = i * PageSize;
+            const size_t length = std::min(PageSize, byteCount - offset);
+
+            // Share the previous page when the bytes it covers have not changed.
+            if (i < previous.pages.size() && offset + length <= previous.bytes && std::memcmp(previous.pages[i]->bytes, source + offset, length) == 0)
+            {
+                captured[i] = previous.pages[i];
+                continue;
+            }
+
+            if (!freePages.empty())
+            {
+                captured[i] = std::move(freePages.back());
+                freePages.pop_back();
+            }
+            else
+            {
+                captured[i] = std::make_shared<Page>();
+            }
+
+            std::memcpy(captured[i]->bytes, source + offset, length);
+        }
+
+        Release(freePages);
+        pages = std::move(captured);
+        bytes = byteCount;
+    }
+
+    void PagedSnapshot::Apply(void* data) const noexcept
+    {
+        std::byte* destination = static_cast<std::byte*>(data);
+
+        for (size_t i = 0; i < pages.size(); ++i)
+        {
+            const size_t offset = i * PageSize;
+            std::memcpy(destination + offset, pages[i]->bytes, std::min(PageSize, bytes - offset));
+        }
+    }
+
+    void PagedSnapshot::Release(PagePool& freePages) noexcept
+    {
+        // A page with a single owner is not shared with any other tick, so it can be recycled.
+        for (std::shared_ptr<Page>& page : pages)
+        {
+            if (page.use_count() == 1) { freePages.push_back(std::move(page)); }
+        }
+
+        pages.clear();
+        bytes = 0;
+    }
+
+    RollbackBuffer::RollbackBuffer(EntityManager& entityManager, ComponentManager& componentManager, size_t capacity) : entities(entityManager), components(componentManager)
+    {
+        SetCapacity(capacity);
+    }
+
+    bool RollbackBuffer::SaveTick(uint32_t tick)
+    {
+        if (tick == NoTick) { TE_LOG_ERROR("RollbackBuffer: Tick '{}' is reserved.", tick); return false; }
+
+        const size_t slot = SlotOf(tick);
+
+        // Reserved Entities are committed first so that the snapshot describes a settled free-list.
+        if (entities.HasReserved()) { entities.FlushReserved(); }
+
+        EntityState& state = entityStates[slot];
+        state.slots.Capture(entities.slots.data(), entities.slots.size() * sizeof(EntityManager::Slot), entityStates[lastSlot].slots, freePages);
+        state.freeHead = entities.committedHead;
+
+        for (const auto& track : tracks) { track->Save(slot, lastSlot, freePages); }
+
+        slotTicks[slot] = tick;
+        lastSlot = slot;
+        return true;
+    }
+
+    bool RollbackBuffer::RestoreTick(uint32_t tick)
+    {
+        if (!HasTick(tick))
+        {
+            TE_LOG_WARN("RollbackBuffer: Tick '{}' is not in the buffer.", tick);
+            return false;
+        }
+
+        const size_t slot = SlotOf(tick);
+
+        const EntityState& state = entityStates[slot];
+        entities.slots.resize(state.slots.Bytes() / sizeof(EntityManager::Slot));
+        state.slots.Apply(entities.slots.data());
+        entities.committedHead = state.freeHead;
+        entities.freeHead.store(state.freeHead, std::memory_order_relaxed);
+        entities.reservedCount.store(0, std::memory_order_relaxed);
+
+        for (const auto& track : tracks) { track->Restore(slot); }
+
+        // Registered pools now match the restored Entities; unregistered ones may still hold Components of Entities created after `tick`.
+        for (const auto& [typeIndex, pool] : components.pools)
+        {
+            if (!registered.contains(typeIndex)) { pool->RemoveDead(entities); }
+        }
+
+        // Newer ticks belong to the timeline being rolled back.
+        for (uint32_t& slotTick : slotTicks)
+        {
+            if (slotTick != NoTick && slotTick > tick) { slotTick = NoTick; }
+        }
+
+        lastSlot = slot;
+        return true;
+    }
+
+    void RollbackBuffer::SetCapacity(size_t newCapacity)
+    {
+        capacity = std::max<size_t>(newCapacity, 1);
+
+        for (EntityState& state : entityStates) { state.slots.Release(freePages); }
+        entityStates.clear();
+        entityStates.resize(capacity);
+
+        for (const auto& track : tracks) { track->Resize(capacity, freePages); }
+
+        slotTicks.assign(capacity, NoTick);
+        lastSlot = 0;
+    }
+
+    void RollbackBuffer::Invalidate() noexcept
+    {
+        std::fill(slotTicks.begin(), slotTicks.end(), NoTick);
+    }
+
+    void RollbackBuffer::ReportMemory(MemoryReport& report) const
+    {
+        std::unordered_set<const void*> pages;
+        for (const EntityState& state : entityStates) { state.slots.CollectPages(pages); }
+        for (const auto& track : tracks) { track->CollectPages(pages); }
+
+        const size_t usedBytes = pages.size() * PagedSnapshot::PageSize;
+        report.Add("Rollback/pages", { usedBytes, usedBytes + freePages.size() * PagedSnapshot::PageSize });
+    }
+
+    void RollbackBuffer::Reset() noexcept
+    {
+        tracks.clear();
+        registered.clear();
+        for (EntityState& state : entityStates) { state.slots.Release(freePages); }
+        freePages.clear();
+        Invalidate();
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef TERRANENGINE_ROLLBACKBUFFER_H
+#define TERRANENGINE_ROLLBACKBUFFER_H
+
+#include "engine/ecs/world/ComponentManager.h"
+#include "engine/ecs/world/EntityManager.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <typeindex>
+#include <unordered_set>
+#include <vector>
+#include <type_traits>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Paged copy of a contiguous byte range.
+     *
+     * ### Delta Tracking.
+     *
+     * The captured bytes are split into fixed-size pages. When capturing, every page is compared against the same page of the previously captured snapshot.
+     * Unchanged pages are shared (reference counted) with the previous snapshot instead of being copied, so a tick in which only a few components changed
+     * costs a compare over the range plus a copy of the dirty pages only.
+     */
+    class PagedSnapshot
+    {
+    public:
+        static constexpr size_t PageSize = 4096;
+
+        struct Page { std::byte bytes[PageSize]; };
+        using PagePool = std::vector<std::shared_ptr<Page>>;
+
+        /** Capture `byteCount` bytes from `data`, sharing pages that are unchanged since `previous`. Released pages are recycled through `freePages`. */
+        void Capture(const void* data, size_t byteCount, const PagedSnapshot& previous, PagePool& freePages);
+
+        /** Copy the captured bytes back into `data`, which must hold at least `Bytes()` bytes. */
+        void Apply(void* data) const noexcept;
+
+        /** Drop all pages, handing back those that are no longer shared with another snapshot. */
+        void Release(PagePool& freePages) noexcept;
+
+        [[nodiscard]] size_t Bytes() const noexcept { return bytes; }
+
+        /** Gather the addresses of held pages; pages shared between snapshots are only counted once. */
+        void CollectPages(std::unordered_set<const void*>& pageSet) const { for (const auto& page : pages) { pageSet.insert(page.get()); } }
+
+    private:
+        std::vector<std::shared_ptr<Page>> pages;
+        size_t bytes {0};
+    };
+
+    /**
+     * @brief Rollback Buffer stores a ring of World snapshots for rollback and deterministic replay.
+     *
+     * ### Snapshot Storage.
+     *
+     * Only the Entity slots and Component Pools registered through `Register<T>()` are captured. Registered Components must be trivially copyable, as pool storage is copied byte-wise.
+     * Each registered pool captures its dense, entity and sparse arrays as `PagedSnapshots`, so unchanged regions are shared between neighbouring ticks rather than copied.
+     *
+     * Tick `n` lives in ring slot `n % capacity`. Saving a tick overwrites whatever tick previously occupied its slot.
+     * Restoring a tick discards every saved tick that is newer than it, as those ticks no longer describe the resimulated timeline.
+     *
+     * Unregistered pools (e.g. `BehaviourComponent`) keep their current Components through a restore, except those of Entities that are not alive at
+     * the restored tick. These are removed, so that a later Entity given the same index and generation does not inherit them.
+     */
+    class RollbackBuffer
+    {
+    public:
+        static constexpr size_t DefaultCapacity = 8;
+
+        RollbackBuffer(EntityManager& entityManager, ComponentManager& componentManager, size_t capacity = DefaultCapacity);
+        ~RollbackBuffer() = default;
+
+        RollbackBuffer(const RollbackBuffer&)            = delete;
+        RollbackBuffer& operator=(const RollbackBuffer&) = delete;
+
+        /** Include all Components of type T in future snapshots. Registering a new type invalidates previously saved ticks. */
+        template<typename T>
+        void Register()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Rollback Components must be trivially copyable.");
+            static_assert(std::is_default_constructible_v<T>, "Rollback Components must be default constructible.");
+
+            tracks.emplace_back(std::make_unique<PoolTrack<T>>(components, capacity));
+            registered.emplace(typeid(T));
+            Invalidate();
+        }
+
+        /** Capture the registered World state as `tick`. */
+        bool SaveTick(uint32_t tick);
+
+        /** Return the registered World state to how it was when `tick` was saved. Returns false if `tick` is no longer in the ring. */
+        bool RestoreTick(uint32_t tick);
+
+        [[nodiscard]] bool   HasTick(uint32_t tick) const noexcept { return tick != NoTick && slotTicks[SlotOf(tick)] == tick; }
+        [[nodiscard]] size_t Capacity()             const noexcept { return capacity; }
+
+        /** Resize the ring. Discards every saved tick. */
+        void SetCapacity(size_t newCapacity);
+
+        /** Discard every saved tick, keeping registrations. */
+        void Invalidate() noexcept;
+
+        /** Discard every saved tick and registration. */
+        void Reset() noexcept;
+
+        /** Reports unique snapshot pages as used, and recycled pages as reserved only. */
+        void ReportMemory(MemoryReport& report) const;
+
+    private:
+        /** Non-templated interface so registered pools can be stored heterogenously. */
+        class ITrack
+        {
+        public:
+            virtual ~ITrack() = default;
+            virtual void Save(size_t slot, size_t previousSlot, PagedSnapshot::PagePool& freePages) = 0;
+            virtual void Restore(size_t slot) = 0;
+            virtual void Resize(size_t slotCount, PagedSnapshot::PagePool& freePages) = 0;
+            virtual void CollectPages(std::unordered_set<const void*>& pages) const = 0;
+        };
+
+        template<typename T>
+        class PoolTrack final : public ITrack
+        {
+        public:
+            PoolTrack(ComponentManager& componentManager, size_t slotCount) : components(componentManager), states(slotCount) {}
+
+            void Save(size_t slot, size_t previousSlot, PagedSnapshot::PagePool& freePages) override
+            {
+                const ComponentPool<T>& pool  = components.GetOrCreatePool<T>();
+                const State&            prior = states[previousSlot];
+                State&                  state = states[slot];
+
+                state.data.Capture(pool.denseData.data(), pool.denseData.size() * sizeof(T), prior.data, freePages);
+                state.entities.Capture(pool.denseEntities.data(), pool.denseEntities.size() * sizeof(Entity), prior.entities, freePages);
+                state.sparse.Capture(pool.sparseIndices.data(), pool.sparseIndices.size() * sizeof(uint32_t), prior.sparse, freePages);
+            }
+
+            void Restore(size_t slot) override
+            {
+                ComponentPool<T>& pool  = components.GetOrCreatePool<T>();
+                const State&      state = states[slot];
+
+                pool.denseData.resize(state.data.Bytes() / sizeof(T));
+                pool.denseEntities.resize(state.entities.Bytes() / sizeof(Entity));
+                pool.sparseIndices.resize(state.sparse.Bytes() / sizeof(uint32_t));
+
+                state.data.Apply(pool.denseData.data());
+                state.entities.Apply(pool.denseEntities.data());
+                state.sparse.Apply(pool.sparseIndices.data());
+            }
+
+            void CollectPages(std::unordered_set<const void*>& pages) const override
+            {
+                for (const State& state : states) { state.data.CollectPages(pages); state.entities.CollectPages(pages); state.sparse.CollectPages(pages); }
+            }
+
+            void Resize(size_t slotCount, PagedSnapshot::PagePool& freePages) override
+            {
+                for (State& state : states) { state.data.Release(freePages); state.entities.Release(freePages); state.sparse.Release(freePages); }
+                states.clear();
+                states.resize(slotCount);
+            }
+
+        private:
+            struct State
+            {
+                PagedSnapshot data;
+                PagedSnapshot entities;
+                PagedSnapshot sparse;
+            };
+
+            ComponentManager&  components;
+            std::vector<State> states;
+        };
+
+        struct EntityState
+        {
+            PagedSnapshot slots;
+            uint32_t      freeHead {EntityManager::Invalid};
+        };
+
+        [[nodiscard]] size_t SlotOf(uint32_t tick) const noexcept { return tick % capacity; }
+
+    private:
+        EntityManager&    entities;
+        ComponentManager& components;
+
+        std::vector<std::unique_ptr<ITrack>> tracks;
+        std::unordered_set<std::type_index>  registered; // Types of the pools in `tracks`.
+        std::vector<EntityState>             entityStates;
+        std::vector<uint32_t>                slotTicks;
+
+        PagedSnapshot::PagePool freePages;
+
+        size_t capacity {DefaultCapacity};
+        size_t lastSlot {0};
+
+        static constexpr uint32_t NoTick = 0xFFFFFFFFu;
+    };
+}
+
+#endif // TERRANENGINE_ROLLBACKBUFFER_H
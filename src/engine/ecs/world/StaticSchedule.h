@@ -0,0 +1,66 @@
+#ifndef TERRANENGINE_STATICSCHEDULE_H
+#define TERRANENGINE_STATICSCHEDULE_H
+
+#include "engine/ecs/world/World.h"
+
+#include <concepts>
+#include <tuple>
+#include <utility>
+
+namespace TerranEngine
+{
+    /** Any type with `Update(World&, float)` can run in a `StaticSchedule`; deriving from `System` is not required. */
+    template<typename T>
+    concept StaticSystem = requires(T system, World& world, float deltaTime) { system.Update(world, deltaTime); };
+
+    /**
+     * @brief Compile-time alternative to the `SystemScheduler` for fixed pipelines (e.g. headless server simulation).
+     *
+     * ### System Storage.
+     *
+     * Systems are stored by value in a tuple and run in template order. Each `Update` is called through the concrete type with a qualified call,
+     * so no virtual dispatch takes place and the whole pipeline can be inlined into `StaticSchedule::Update`.
+     *
+     * `Bind()` resolves the Queries of every System that exposes `Bind(World&)` up front, so the first frame does not pay for pool lookups.
+     * Like the `SystemScheduler`, reserved Entities are committed after every System.
+     */
+    template<StaticSystem... Systems>
+    class StaticSchedule
+    {
+    public:
+        StaticSchedule() = default;
+        explicit StaticSchedule(Systems... systems) : systems(std::move(systems)...) {}
+
+        void Bind(World& world)
+        {
+            std::apply([&world](auto&... system) { (BindSystem(system, world), ...); }, systems);
+        }
+
+        void Update(World& world, float deltaTime)
+        {
+            std::apply([&world, deltaTime](auto&... system) { (RunSystem(system, world, deltaTime), ...); }, systems);
+        }
+
+        template<typename T>
+        [[nodiscard]] T& Get() noexcept { return std::get<T>(systems); }
+
+    private:
+        template<typename T>
+        static void BindSystem(T& system, World& world)
+        {
+            if constexpr (requires { system.Bind(world); }) { system.Bind(world); }
+        }
+
+        template<typename T>
+        static void RunSystem(T& system, World& world, float deltaTime)
+        {
+            system.T::Update(world, deltaTime); // Qualified call: never dispatched virtually.
+            world.FlushReservedEntities();
+        }
+
+    private:
+        std::tuple<Systems...> systems;
+    };
+}
+
+#endif // TERRANENGINE_STATICSCHEDULE_H
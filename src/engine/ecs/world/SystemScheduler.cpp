@@ -1,5 +1,6 @@
 #include "engine/ecs/world/SystemScheduler.h"
 #include "engine/ecs/world/World.h"
+#include "engine/core/Time.h"
 
 namespace TerranEngine
 {
@@ -7,9 +8,31 @@ namespace TerranEngine
     {
         Clean();
 
-        for (Entry& entry : entries)
+        // Entries are phase-sorted, so the fixed phase is one contiguous range.
+        const auto fixedFirst = std::ranges::partition_point(entries, [](const Entry& entry) { return entry.systemPhase <  SystemPhase::FIXEDUPDATE; });
+        const auto fixedLast  = std::ranges::partition_point(entries, [](const Entry& entry) { return entry.systemPhase <= SystemPhase::FIXEDUPDATE; });
+
+        const int   fixedSteps = Time::ConsumeFixedTicks();
+        const float fixedDelta = Time::FixedDeltaTime();
+
+        RunRange(world, entries.begin(), fixedFirst, deltaTime);
+
+        for (int i = 0; i < fixedSteps; ++i)
+        {
+            RunRange(world, fixedFirst, fixedLast, fixedDelta);
+        }
+
+        RunRange(world, fixedLast, entries.end(), deltaTime);
+    }
+
+    void SystemScheduler::RunRange(World& world, EntryIterator first, EntryIterator last, float deltaTime)
+    {
+        for (EntryIterator entry = first; entry != last; ++entry)
         {
-            entry.system->Update(world, deltaTime);
+            entry->system->Update(world, deltaTime);
+
+            // Sync point: commit Entities reserved by jobs spawned from the System.
+            world.FlushReservedEntities();
         }
     }
-}
\ No newline at end of file
+}
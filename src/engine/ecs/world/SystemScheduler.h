@@ -11,10 +11,11 @@ namespace TerranEngine
 {
     enum class SystemPhase : int
     {
-        PREUPDATE  = 0,
-        UPDATE     = 1,
-        POSTUPDATE = 2,
-        RENDER     = 3
+        PREUPDATE   = 0,
+        FIXEDUPDATE = 1, // Runs once per pending fixed tick, with the fixed delta-time.
+        UPDATE      = 2,
+        POSTUPDATE  = 3,
+        RENDER      = 4
     };
 
     /**
@@ -27,6 +28,11 @@ namespace TerranEngine
      * 
      * A `dirty` 'entries' vector indicates that the vector may not be in priority order; cleaning the vector sorts it into priority ONLY when it is flagged as dirty.
      * This allows the vector to be iterated through while preserving phase/priority without further sorting.
+     *
+     * ### Fixed Phase.
+     *
+     * The `FIXEDUPDATE` range of the vector is run once for every fixed tick consumed from `Time` this frame (zero or more times), with `Time::FixedDeltaTime()`.
+     * The number of ticks per frame is capped by `Time::SetMaxFixedTicks()`.
      */
     class SystemScheduler
     {
@@ -51,10 +57,27 @@ namespace TerranEngine
             return Add<T>(SystemPhase::UPDATE, 0, std::forward<Args>(args)...);
         }
 
+        /** First registered System of type T, or `nullptr`. */
+        template<typename T>
+        [[nodiscard]] T* Get() const noexcept
+        {
+            for (const Entry& entry : entries)
+            {
+                if (T* system = dynamic_cast<T*>(entry.system.get())) { return system; }
+            }
+
+            return nullptr;
+        }
+
         void UpdateAll(World& world, float deltaTime);
 
         void Reset() { entries.clear(); }
 
+        void ReportMemory(MemoryReport& report) const
+        {
+            for (const Entry& entry : entries) { entry.system->ReportMemory(report); }
+        }
+
     private:
         void Clean()
         {
@@ -78,6 +101,10 @@ namespace TerranEngine
             int                     priority;
         };
 
+        using EntryIterator = std::vector<Entry>::iterator;
+
+        static void RunRange(World& world, EntryIterator first, EntryIterator last, float deltaTime);
+
         std::vector<Entry> entries;
         bool dirty {false};
     };
@@ -5,19 +5,25 @@
 #include "engine/ecs/world/ComponentManager.h"
 #include "engine/ecs/world/SystemScheduler.h"
 #include "engine/ecs/world/QueryEngine.h"
+#include "engine/ecs/world/RollbackBuffer.h"
 
 namespace TerranEngine
 {
     /**
-     * @brief World acts as a facade for the underlying `ComponentManager`, `EntityManager`, `SystemScheduler`, and `QueryEngine` classes, abstracting them away from the public interface.
+     * @brief World acts as a facade for the underlying `ComponentManager`, `EntityManager`, `SystemScheduler`, `QueryEngine`, and `RollbackBuffer` classes, abstracting them away from the public interface.
      */
     class World
     {
     public:
-        World() : querier{components} {}
+        World() : querier{components}, rollback{entities, components} {}
         ~World() = default;
 
         [[nodiscard]] Entity CreateEntity() { return entities.CreateEntity(); }
+
+        /** Thread-safe. The returned Entity becomes alive at the next sync point (after the running System finishes). */
+        [[nodiscard]] Entity ReserveEntity() noexcept { return entities.ReserveEntity(); }
+        void ReserveEntities(Entity* outEntities, uint32_t count) noexcept { entities.ReserveEntities(outEntities, count); }
+        void FlushReservedEntities() { if (entities.HasReserved()) { entities.FlushReserved(); } }
         void DestroyEntity(Entity entity) { entities.DestroyEntity(entity); }
         [[nodiscard]] bool IsAlive(Entity entity) const { return entities.IsAlive(entity); }
 
@@ -40,14 +46,47 @@ namespace TerranEngine
         template<typename... Components, typename Function>
         void ForEach(Function&& function) { querier.ForEach<Components...>(std::forward<Function>(function)); }
 
+        /** Bind a System-owned Query to this World's pools. No-op when it is already bound. */
+        template<typename... Components>
+        void BindQuery(Query<Components...>& query) { querier.Bind(query); }
+
         template<typename System, typename... Args>
         System& AddSystem(SystemPhase phase = SystemPhase::UPDATE, int priority = 0, Args&&... args) { return scheduler.Add<System>(phase, priority, std::forward<Args>(args)...); }
 
+        /** Look up a registered System (e.g. the `SpatialHashSystem`) to call into it. Returns `nullptr` if none is registered. */
+        template<typename System>
+        [[nodiscard]] System* GetSystem() const noexcept { return scheduler.Get<System>(); }
+
         void UpdateSystems(float deltaTime) { scheduler.UpdateAll(*this, deltaTime); }
 
+        /** Include Components of type T (which must be trivially copyable) in rollback snapshots. */
+        template<typename T>
+        void RegisterRollback() { rollback.Register<T>(); }
+
+        /** Snapshot the Entities and registered Components as fixed-tick `tick`. */
+        bool SaveTick(uint32_t tick) { return rollback.SaveTick(tick); }
+
+        /** Return the Entities and registered Components to the state saved for `tick`. */
+        bool RestoreTick(uint32_t tick) { return rollback.RestoreTick(tick); }
+
+        void SetRollbackCapacity(size_t tickCount) { rollback.SetCapacity(tickCount); }
+
+        /** Memory held by the Entity slots, every Component Pool, the rollback buffer and every System. */
+        [[nodiscard]] MemoryReport MemoryStats() const
+        {
+            MemoryReport report;
+            entities.ReportMemory(report);
+            components.ReportMemory(report);
+            rollback.ReportMemory(report);
+            scheduler.ReportMemory(report);
+
+            return report;
+        }
+
         void Clear()
         {
             scheduler.Reset();
+            rollback.Reset();
             components.Reset();
             entities.Reset();
         }
@@ -57,6 +96,7 @@ namespace TerranEngine
         ComponentManager components;
         SystemScheduler  scheduler;
         QueryEngine      querier;
+        RollbackBuffer   rollback;
     };
 }
 
@@ -0,0 +1,27 @@
+#ifndef TERRANENGINE_BLENDMODE_H
+#define TERRANENGINE_BLENDMODE_H
+
+#include <glad/gl.h>
+
+#include <cstdint>
+
+namespace TerranEngine
+{
+    /** How a sprite's colour is combined with what is already drawn. `Alpha` is the state `WindowManager` sets up. */
+    enum class BlendMode : uint8_t
+    {
+        Alpha,    // Source over destination by source alpha.
+        Additive, // Source added, scaled by source alpha. For glows and sparks.
+    };
+
+    inline void ApplyBlendMode(BlendMode mode) noexcept
+    {
+        switch (mode)
+        {
+            case BlendMode::Alpha:    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+            case BlendMode::Additive: glBlendFunc(GL_SRC_ALPHA, GL_ONE);                 break;
+        }
+    }
+}
+
+#endif // TERRANENGINE_BLENDMODE_H
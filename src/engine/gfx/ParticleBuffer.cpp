@@ -0,0 +1,152 @@
+#include "engine/gfx/ParticleBuffer.h"
+
+#include "engine/gfx/SpriteBatch.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TE_PARTICLES_SSE 1
+#else
+    #define TE_PARTICLES_SSE 0
+#endif
+
+namespace TerranEngine
+{
+    void ParticleBuffer::Simulate(float deltaTime, const glm::vec2& acceleration) noexcept
+    {
+        float* const x    = positionX.data();
+        float* const y    = positionY.data();
+        float* const vx   = velocityX.data();
+        float* const vy   = velocityY.data();
+        float* const ages = age.data();
+        const float* life = inverseLifetime.data();
+
+        size_t firstExpired = count;
+        size_t i            = 0;
+
+        glm::vec2 minimum {std::numeric_limits<float>::infinity()};
+        glm::vec2 maximum {-std::numeric_limits<float>::infinity()};
+
+#if TE_PARTICLES_SSE
+        const __m128 dt  = _mm_set1_ps(deltaTime);
+        const __m128 ax  = _mm_set1_ps(acceleration.x * deltaTime);
+        const __m128 ay  = _mm_set1_ps(acceleration.y * deltaTime);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        __m128 minX = _mm_set1_ps(minimum.x), minY = _mm_set1_ps(minimum.y);
+        __m128 maxX = _mm_set1_ps(maximum.x), maxY = _mm_set1_ps(maximum.y);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 newVX  = _mm_add_ps(_mm_loadu_ps(vx + i), ax);
+            const __m128 newVY  = _mm_add_ps(_mm_loadu_ps(vy + i), ay);
+            const __m128 newX   = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(newVX, dt));
+            const __m128 newY   = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(newVY, dt));
+            const __m128 newAge = _mm_add_ps(_mm_loadu_ps(ages + i), dt);
+
+            _mm_storeu_ps(vx + i, newVX);
+            _mm_storeu_ps(vy + i, newVY);
+            _mm_storeu_ps(x + i, newX);
+            _mm_storeu_ps(y + i, newY);
+            _mm_storeu_ps(ages + i, newAge);
+
+            minX = _mm_min_ps(minX, newX); maxX = _mm_max_ps(maxX, newX);
+            minY = _mm_min_ps(minY, newY); maxY = _mm_max_ps(maxY, newY);
+
+            if (firstExpired == count && _mm_movemask_ps(_mm_cmpge_ps(_mm_mul_ps(newAge, _mm_loadu_ps(life + i)), one))) { firstExpired = i; }
+        }
+
+        alignas(16) float lanes[4][4];
+        _mm_store_ps(lanes[0], minX); _mm_store_ps(lanes[1], minY);
+        _mm_store_ps(lanes[2], maxX); _mm_store_ps(lanes[3], maxY);
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            minimum = glm::min(minimum, glm::vec2 {lanes[0][lane], lanes[1][lane]});
+            maximum = glm::max(maximum, glm::vec2 {lanes[2][lane], lanes[3][lane]});
+        }
+#endif
+
+        // Scalar tail, or every particle without SSE2.
+        for (; i < count; ++i)
+        {
+            vx[i]   += acceleration.x * deltaTime;
+            vy[i]   += acceleration.y * deltaTime;
+            x[i]    += vx[i] * deltaTime;
+            y[i]    += vy[i] * deltaTime;
+            ages[i] += deltaTime;
+
+            minimum = glm::min(minimum, glm::vec2 {x[i], y[i]});
+            maximum = glm::max(maximum, glm::vec2 {x[i], y[i]});
+
+            if (firstExpired == count && ages[i] * life[i] >= 1.0f) { firstExpired = i; }
+        }
+
+        boundsMin = minimum;
+        boundsMax = maximum;
+
+        if (firstExpired < count) { Compact(firstExpired); }
+    }
+
+    void ParticleBuffer::Compact(size_t first) noexcept
+    {
+        size_t write = first;
+
+        for (size_t read = first; read < count; ++read)
+        {
+            if (age[read] * inverseLifetime[read] >= 1.0f) { continue; }
+
+            positionX[write]       = positionX[read];
+            positionY[write]       = positionY[read];
+            velocityX[write]       = velocityX[read];
+            velocityY[write]       = velocityY[read];
+            age[write]             = age[read];
+            inverseLifetime[write] = inverseLifetime[read];
+            ++write;
+        }
+
+        count = write;
+    }
+
+    void ParticleBuffer::WriteQuads(Vertex* out, const ParticleLook& look) const noexcept
+    {
+        const glm::vec2 sizeDelta   = look.endSize - look.startSize;
+        const glm::vec4 colourDelta = look.endColour - look.startColour;
+
+        for (size_t i = 0; i < count; ++i, out += 4)
+        {
+            const float     t      = std::min(age[i] * inverseLifetime[i], 1.0f);
+            const glm::vec2 half   = (look.startSize + sizeDelta * t) * 0.5f;
+            const glm::vec4 colour = look.startColour + colourDelta * t;
+
+            const float left   = positionX[i] - half.x, right = positionX[i] + half.x;
+            const float bottom = positionY[i] - half.y, top   = positionY[i] + half.y;
+
+            out[0] = { {left,  bottom}, {look.uvMin.x, look.uvMin.y}, colour, look.depth };
+            out[1] = { {right, bottom}, {look.uvMax.x, look.uvMin.y}, colour, look.depth };
+            out[2] = { {right, top},    {look.uvMax.x, look.uvMax.y}, colour, look.depth };
+            out[3] = { {left,  top},    {look.uvMin.x, look.uvMax.y}, colour, look.depth };
+        }
+    }
+
+    void ParticleBuffer::Grow(size_t required)
+    {
+        const size_t newSize = std::max<size_t>(required, positionX.size() ? positionX.size() * 2 : 256);
+
+        positionX.resize(newSize);
+        positionY.resize(newSize);
+        velocityX.resize(newSize);
+        velocityY.resize(newSize);
+        age.resize(newSize);
+        inverseLifetime.resize(newSize);
+    }
+
+    MemoryUsage ParticleBuffer::Memory() const noexcept
+    {
+        // Every array has the same length, and only the first `count` entries are live.
+        const MemoryUsage array = VectorMemory(positionX, count);
+        return { array.used * 6, array.reserved * 6 };
+    }
+}
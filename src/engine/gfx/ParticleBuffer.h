@@ -0,0 +1,95 @@
+#ifndef TERRANENGINE_PARTICLEBUFFER_H
+#define TERRANENGINE_PARTICLEBUFFER_H
+
+#include "engine/core/MemoryReport.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace TerranEngine
+{
+    struct Vertex;
+
+    /** How a `ParticleBuffer` turns its particles into quads. Size and colour are interpolated over each particle's life. */
+    struct ParticleLook
+    {
+        glm::vec2 uvMin       {0.0f, 0.0f};
+        glm::vec2 uvMax       {1.0f, 1.0f};
+        glm::vec2 startSize   {16.0f, 16.0f};
+        glm::vec2 endSize     {16.0f, 16.0f};
+        glm::vec4 startColour {1.0f, 1.0f, 1.0f, 1.0f};
+        glm::vec4 endColour   {1.0f, 1.0f, 1.0f, 1.0f};
+        float     depth       {0.0f};
+    };
+
+    /**
+     * @brief Live particles of one emitter, stored as parallel arrays (one per attribute) so simulation reads and writes contiguous floats.
+     *
+     * ### Simulation.
+     *
+     * `Simulate` integrates velocity and position and ages every particle four at a time with SSE2 (scalar elsewhere), and tracks the bounds of all positions.
+     * Expired particles are then compacted away in one pass starting at the first expired one, keeping the survivors in order. `Spawn` grows the
+     * bounds to cover each new particle, so they hold every live particle whichever of the two ran last.
+     *
+     * ### Rendering.
+     *
+     * `WriteQuads` writes four vertices per particle straight into memory reserved with `SpriteBatch::AllocateQuads`, bypassing per-sprite submission.
+     */
+    class ParticleBuffer
+    {
+    public:
+        /** Add a particle unless the buffer already holds `capacity` particles. */
+        void Spawn(const glm::vec2& position, const glm::vec2& velocity, float lifetime, size_t capacity)
+        {
+            if (count >= capacity || lifetime <= 0.0f) { return; }
+            if (count == positionX.size()) { Grow(count + 1); }
+
+            positionX[count]       = position.x;
+            positionY[count]       = position.y;
+            velocityX[count]       = velocity.x;
+            velocityY[count]       = velocity.y;
+            age[count]             = 0.0f;
+            inverseLifetime[count] = 1.0f / lifetime;
+
+            // The first particle replaces the bounds, which may be stale or empty (+inf / -inf) after the last `Simulate`.
+            boundsMin = count ? glm::min(boundsMin, position) : position;
+            boundsMax = count ? glm::max(boundsMax, position) : position;
+            ++count;
+        }
+
+        /** Advance every particle by `deltaTime` under a constant `acceleration`, then remove the expired ones. */
+        void Simulate(float deltaTime, const glm::vec2& acceleration) noexcept;
+
+        /** Write `Count() * 4` vertices to `out`. */
+        void WriteQuads(Vertex* out, const ParticleLook& look) const noexcept;
+
+        void Clear() noexcept { count = 0; }
+
+        [[nodiscard]] size_t    Count()     const noexcept { return count; }
+        [[nodiscard]] glm::vec2 BoundsMin() const noexcept { return boundsMin; }
+        [[nodiscard]] glm::vec2 BoundsMax() const noexcept { return boundsMax; }
+
+        /** Bytes held by the particle arrays, live particles counted as used. */
+        [[nodiscard]] MemoryUsage Memory() const noexcept;
+
+    private:
+        void Grow(size_t required);
+        void Compact(size_t first) noexcept;
+
+    private:
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> age;
+        std::vector<float> inverseLifetime;
+
+        size_t    count     {0};
+        glm::vec2 boundsMin {0.0f, 0.0f};
+        glm::vec2 boundsMax {0.0f, 0.0f};
+    };
+}
+
+#endif // TERRANENGINE_PARTICLEBUFFER_H
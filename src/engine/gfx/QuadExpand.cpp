@@ -0,0 +1,148 @@
+#include "engine/gfx/QuadExpand.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TE_QUADS_SSE 1
+#else
+    #define TE_QUADS_SSE 0
+#endif
+
+namespace TerranEngine
+{
+    QuadSource MakeQuadSource(const Transform2D& transform, const Sprite& sprite, const glm::vec4& uvRect) noexcept
+    {
+        QuadSource source;
+        source.position = transform.position;
+        source.size     = sprite.size * transform.scale;
+        source.anchor   = sprite.anchor;
+        source.sine     = transform.rotation != 0.0f ? std::sin(transform.rotation) : 0.0f;
+        source.cosine   = transform.rotation != 0.0f ? std::cos(transform.rotation) : 1.0f;
+        source.uvRect   = uvRect;
+        source.colour   = sprite.tint;
+        source.depth    = static_cast<float>(sprite.zLevel) * 0.01f;
+        return source;
+    }
+
+    void ExpandQuadsScalar(const QuadSource* sources, size_t count, Vertex* out) noexcept
+    {
+        for (size_t i = 0; i < count; ++i, out += 4)
+        {
+            const QuadSource& source = sources[i];
+
+            // Corner offsets from the anchor, unrotated.
+            const float left   = -source.anchor.x * source.size.x;
+            const float right  = left + source.size.x;
+            const float bottom = -source.anchor.y * source.size.y;
+            const float top    = bottom + source.size.y;
+
+            const float leftC   = left * source.cosine,   leftS   = left * source.sine;
+            const float rightC  = right * source.cosine,  rightS  = right * source.sine;
+            const float bottomC = bottom * source.cosine, bottomS = bottom * source.sine;
+            const float topC    = top * source.cosine,    topS    = top * source.sine;
+
+            const glm::vec2& position = source.position;
+            const glm::vec4& uv       = source.uvRect;
+
+            out[0] = { {position.x + leftC - bottomS, position.y + leftS + bottomC},   {uv.x, uv.y}, source.colour, source.depth };
+            out[1] = { {position.x + rightC - bottomS, position.y + rightS + bottomC}, {uv.z, uv.y}, source.colour, source.depth };
+            out[2] = { {position.x + rightC - topS, position.y + rightS + topC},       {uv.z, uv.w}, source.colour, source.depth };
+            out[3] = { {position.x + leftC - topS, position.y + leftS + topC},         {uv.x, uv.w}, source.colour, source.depth };
+        }
+    }
+
+#if TE_QUADS_SSE
+    // The kernel loads a source's first eight floats as two registers, and stores a vertex as position + UV, then colour, then depth.
+    static_assert(offsetof(QuadSource, size) == 2 * sizeof(float) && offsetof(QuadSource, anchor) == 4 * sizeof(float));
+    static_assert(offsetof(QuadSource, sine) == 6 * sizeof(float) && offsetof(QuadSource, cosine) == 7 * sizeof(float));
+    static_assert(offsetof(Vertex, uv) == 2 * sizeof(float) && offsetof(Vertex, colour) == 4 * sizeof(float));
+    static_assert(offsetof(Vertex, depth) == 8 * sizeof(float) && sizeof(Vertex) == 9 * sizeof(float));
+
+    /** Write `source`'s four vertices, given each corner's position in the low two floats of `bottomLeft` to `topLeft`. */
+    static void StoreQuad(const QuadSource& source, __m128 bottomLeft, __m128 bottomRight, __m128 topRight, __m128 topLeft, Vertex* out) noexcept
+    {
+        // Corner UVs in the low two floats: (min x, min y), (max x, min y), (max x, max y), (min x, max y).
+        const __m128 uv     = _mm_loadu_ps(&source.uvRect.x);
+        const __m128 colour = _mm_loadu_ps(&source.colour.x);
+        float*       vertex = reinterpret_cast<float*>(out);
+
+        _mm_storeu_ps(vertex,      _mm_movelh_ps(bottomLeft, uv));
+        _mm_storeu_ps(vertex + 9,  _mm_movelh_ps(bottomRight, _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 2, 1, 2))));
+        _mm_storeu_ps(vertex + 18, _mm_movelh_ps(topRight, _mm_movehl_ps(uv, uv)));
+        _mm_storeu_ps(vertex + 27, _mm_movelh_ps(topLeft, _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 2, 3, 0))));
+
+        for (int corner = 0; corner < 4; ++corner, vertex += 9)
+        {
+            _mm_storeu_ps(vertex + 4, colour);
+            vertex[8] = source.depth;
+        }
+    }
+
+    /** Expand `sources[0..3]`, one sprite per lane. Same operations in the same order as `ExpandQuadsScalar`, so the corners match exactly. */
+    static void ExpandFour(const QuadSource* sources, Vertex* out) noexcept
+    {
+        // Loaded one source per register; named for what each register holds after the transposes.
+        __m128 positionX = _mm_loadu_ps(&sources[0].position.x), anchorX = _mm_loadu_ps(&sources[0].anchor.x);
+        __m128 positionY = _mm_loadu_ps(&sources[1].position.x), anchorY = _mm_loadu_ps(&sources[1].anchor.x);
+        __m128 sizeX     = _mm_loadu_ps(&sources[2].position.x), sine    = _mm_loadu_ps(&sources[2].anchor.x);
+        __m128 sizeY     = _mm_loadu_ps(&sources[3].position.x), cosine  = _mm_loadu_ps(&sources[3].anchor.x);
+
+        _MM_TRANSPOSE4_PS(positionX, positionY, sizeX, sizeY);
+        _MM_TRANSPOSE4_PS(anchorX, anchorY, sine, cosine);
+
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+
+        const __m128 left   = _mm_mul_ps(_mm_xor_ps(anchorX, signBit), sizeX);
+        const __m128 right  = _mm_add_ps(left, sizeX);
+        const __m128 bottom = _mm_mul_ps(_mm_xor_ps(anchorY, signBit), sizeY);
+        const __m128 top    = _mm_add_ps(bottom, sizeY);
+
+        const __m128 leftC   = _mm_mul_ps(left, cosine),   leftS   = _mm_mul_ps(left, sine);
+        const __m128 rightC  = _mm_mul_ps(right, cosine),  rightS  = _mm_mul_ps(right, sine);
+        const __m128 bottomC = _mm_mul_ps(bottom, cosine), bottomS = _mm_mul_ps(bottom, sine);
+        const __m128 topC    = _mm_mul_ps(top, cosine),    topS    = _mm_mul_ps(top, sine);
+
+        const __m128 cornerX[4] =
+        {
+            _mm_sub_ps(_mm_add_ps(positionX, leftC), bottomS),
+            _mm_sub_ps(_mm_add_ps(positionX, rightC), bottomS),
+            _mm_sub_ps(_mm_add_ps(positionX, rightC), topS),
+            _mm_sub_ps(_mm_add_ps(positionX, leftC), topS),
+        };
+        const __m128 cornerY[4] =
+        {
+            _mm_add_ps(_mm_add_ps(positionY, leftS), bottomC),
+            _mm_add_ps(_mm_add_ps(positionY, rightS), bottomC),
+            _mm_add_ps(_mm_add_ps(positionY, rightS), topC),
+            _mm_add_ps(_mm_add_ps(positionY, leftS), topC),
+        };
+
+        // Back to one sprite per register: sprites 0 and 1 are the low and high halves of `...Low`, sprites 2 and 3 of `...High`.
+        const __m128 bottomLeftLow   = _mm_unpacklo_ps(cornerX[0], cornerY[0]), bottomLeftHigh  = _mm_unpackhi_ps(cornerX[0], cornerY[0]);
+        const __m128 bottomRightLow  = _mm_unpacklo_ps(cornerX[1], cornerY[1]), bottomRightHigh = _mm_unpackhi_ps(cornerX[1], cornerY[1]);
+        const __m128 topRightLow     = _mm_unpacklo_ps(cornerX[2], cornerY[2]), topRightHigh    = _mm_unpackhi_ps(cornerX[2], cornerY[2]);
+        const __m128 topLeftLow      = _mm_unpacklo_ps(cornerX[3], cornerY[3]), topLeftHigh     = _mm_unpackhi_ps(cornerX[3], cornerY[3]);
+
+        StoreQuad(sources[0], bottomLeftLow, bottomRightLow, topRightLow, topLeftLow, out);
+        StoreQuad(sources[1], _mm_movehl_ps(bottomLeftLow, bottomLeftLow), _mm_movehl_ps(bottomRightLow, bottomRightLow),
+                  _mm_movehl_ps(topRightLow, topRightLow), _mm_movehl_ps(topLeftLow, topLeftLow), out + 4);
+        StoreQuad(sources[2], bottomLeftHigh, bottomRightHigh, topRightHigh, topLeftHigh, out + 8);
+        StoreQuad(sources[3], _mm_movehl_ps(bottomLeftHigh, bottomLeftHigh), _mm_movehl_ps(bottomRightHigh, bottomRightHigh),
+                  _mm_movehl_ps(topRightHigh, topRightHigh), _mm_movehl_ps(topLeftHigh, topLeftHigh), out + 12);
+    }
+#endif
+
+    void ExpandQuads(const QuadSource* sources, size_t count, Vertex* out) noexcept
+    {
+        size_t i = 0;
+
+#if TE_QUADS_SSE
+        for (; i + 4 <= count; i += 4) { ExpandFour(sources + i, out + i * 4); }
+#endif
+
+        // Scalar tail, or every sprite without SSE2.
+        ExpandQuadsScalar(sources + i, count - i, out + i * 4);
+    }
+}
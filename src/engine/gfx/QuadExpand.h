@@ -0,0 +1,45 @@
+#ifndef TERRANENGINE_QUADEXPAND_H
+#define TERRANENGINE_QUADEXPAND_H
+
+#include "engine/gfx/SpriteBatch.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace TerranEngine
+{
+    /** One sprite ready to be expanded into a quad: rotation reduced to its sine and cosine, UVs already resolved. */
+    struct QuadSource
+    {
+        glm::vec2 position; // World position of the anchor.
+        glm::vec2 size;     // World size, scale applied.
+        glm::vec2 anchor;   // Point of the quad (0-1) placed at `position` and rotated about.
+        float     sine;     // Of the rotation.
+        float     cosine;
+        glm::vec4 uvRect;   // UV min, UV max.
+        glm::vec4 colour;
+        float     depth;
+    };
+
+    /**
+     * The `QuadSource` of a sprite drawn at `transform`, with UVs `uvRect`.
+     *
+     * Like `SpriteRenderer::WriteInstance`, it ignores `origin`: the quad is rotated about the anchor directly.
+     */
+    [[nodiscard]] QuadSource MakeQuadSource(const Transform2D& transform, const Sprite& sprite, const glm::vec4& uvRect) noexcept;
+
+    /**
+     * Expand `count` sprites into four `Vertex`es each (bottom-left, bottom-right, top-right, top-left) at `out`.
+     *
+     * Every corner is `position + rotate((corner - anchor) * size)`, the same as `sprite_instanced.vert`, with the rotation taken once per
+     * sprite rather than per corner. With SSE2, four sprites are transposed into one lane each and expanded together; the remainder, or every
+     * sprite without SSE2, goes through `ExpandQuadsScalar`. Both give identical corners.
+     */
+    void ExpandQuads(const QuadSource* sources, size_t count, Vertex* out) noexcept;
+
+    /** `ExpandQuads` one sprite at a time. Kept visible for `terranengine_quadbench`. */
+    void ExpandQuadsScalar(const QuadSource* sources, size_t count, Vertex* out) noexcept;
+}
+
+#endif // TERRANENGINE_QUADEXPAND_H
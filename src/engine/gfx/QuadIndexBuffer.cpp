@@ -0,0 +1,61 @@
+#include "engine/gfx/QuadIndexBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace TerranEngine
+{
+    static constexpr size_t INDICES_PER_QUAD  = 6;
+    static constexpr size_t VERTICES_PER_QUAD = 4;
+
+    std::shared_ptr<const QuadIndexBuffer> QuadIndexBuffer::Acquire()
+    {
+        // Weak, so the buffer is deleted with its last user rather than at static destruction, after the context is gone.
+        static std::weak_ptr<const QuadIndexBuffer> shared;
+
+        std::shared_ptr<const QuadIndexBuffer> buffer = shared.lock();
+        if (!buffer)
+        {
+            buffer = std::shared_ptr<const QuadIndexBuffer>(new QuadIndexBuffer());
+            shared = buffer;
+        }
+
+        return buffer;
+    }
+
+    QuadIndexBuffer::QuadIndexBuffer()
+    {
+        std::vector<uint16_t> indices;
+        indices.reserve(MaxQuads * INDICES_PER_QUAD);
+
+        for (size_t quad = 0; quad < MaxQuads; ++quad)
+        {
+            const uint16_t base = static_cast<uint16_t>(quad * VERTICES_PER_QUAD);
+            const uint16_t quadIndices[INDICES_PER_QUAD] = { base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2), base, static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3) };
+            indices.insert(indices.end(), quadIndices, quadIndices + INDICES_PER_QUAD);
+        }
+
+        glCreateBuffers(1, &id);
+        glNamedBufferStorage(id, static_cast<GLsizeiptr>(indices.size() * sizeof(uint16_t)), indices.data(), 0);
+    }
+
+    QuadIndexBuffer::~QuadIndexBuffer()
+    {
+        glDeleteBuffers(1, &id);
+    }
+
+    void QuadIndexBuffer::Draw(size_t quadCount, size_t firstQuad) noexcept
+    {
+        for (size_t first = 0; first < quadCount; first += MaxQuads)
+        {
+            const size_t count = std::min(MaxQuads, quadCount - first);
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(count * INDICES_PER_QUAD), GL_UNSIGNED_SHORT, nullptr, static_cast<GLint>((firstQuad + first) * VERTICES_PER_QUAD));
+        }
+    }
+
+    size_t QuadIndexBuffer::Bytes() const noexcept
+    {
+        return MaxQuads * INDICES_PER_QUAD * sizeof(uint16_t);
+    }
+}
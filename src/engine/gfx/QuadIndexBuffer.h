@@ -0,0 +1,44 @@
+#ifndef TERRANENGINE_QUADINDEXBUFFER_H
+#define TERRANENGINE_QUADINDEXBUFFER_H
+
+#include <glad/gl.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Immutable index buffer of `MaxQuads` quads (`0 1 2, 0 2 3` per quad), generated once and shared by every quad renderer.
+     *
+     * Indices are 16-bit, so one slice addresses at most 65536 vertices. `Draw` splits larger batches into `MaxQuads` slices, each offset with a
+     * base vertex, so a batch of any size draws correctly with the same buffer.
+     *
+     * The buffer lives as long as someone holds the pointer from `Acquire`, which keeps it from outliving the GL context.
+     */
+    class QuadIndexBuffer
+    {
+    public:
+        static constexpr size_t MaxQuads = 0x10000 / 4;
+
+        [[nodiscard]] static std::shared_ptr<const QuadIndexBuffer> Acquire();
+
+        ~QuadIndexBuffer();
+
+        QuadIndexBuffer(const QuadIndexBuffer&)            = delete;
+        QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+        /** Draw `quadCount` quads, four vertices each from quad `firstQuad` of the bound vertex array. The vertex array must use `ID()` as its element buffer. */
+        static void Draw(size_t quadCount, size_t firstQuad = 0) noexcept;
+
+        [[nodiscard]] GLuint ID()    const noexcept { return id; }
+        [[nodiscard]] size_t Bytes() const noexcept;
+
+    private:
+        QuadIndexBuffer();
+
+        GLuint id {0};
+    };
+}
+
+#endif // TERRANENGINE_QUADINDEXBUFFER_H
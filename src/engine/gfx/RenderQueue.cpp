@@ -0,0 +1,107 @@
+#include "engine/gfx/RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+
+namespace TerranEngine
+{
+    static constexpr uint32_t STATE_BITS = 24; // Blend, pipeline and texture: what a run shares.
+    static constexpr uint64_t STATE_MASK = (uint64_t {1} << STATE_BITS) - 1;
+
+    void RenderQueue::Clear() noexcept
+    {
+        keys.clear();
+        runs.clear();
+        textures.clear();
+        textureSlots.clear();
+        lastTexture = nullptr;
+    }
+
+    bool RenderQueue::TextureSlot(const Texture* texture, uint16_t& slot)
+    {
+        if (texture == lastTexture && texture) { slot = lastSlot; return true; }
+
+        auto it = textureSlots.find(texture);
+        if (it == textureSlots.end())
+        {
+            if (textures.size() == MaxTextures) { return false; }
+
+            it = textureSlots.emplace(texture, static_cast<uint16_t>(textures.size())).first;
+            textures.push_back(texture);
+        }
+
+        lastTexture = texture;
+        lastSlot    = it->second;
+        slot        = lastSlot;
+        return true;
+    }
+
+    bool RenderQueue::Push(int32_t layer, BlendMode blend, uint8_t pipeline, uint16_t textureSlot)
+    {
+        if (keys.size() == MaxItems) { return false; }
+
+        const auto biasedLayer = static_cast<uint64_t>(std::clamp(layer, -0x8000, 0x7FFF) + 0x8000);
+
+        keys.push_back(biasedLayer << 48
+                     | static_cast<uint64_t>(blend) << 46
+                     | static_cast<uint64_t>(pipeline & (MaxPipelines - 1)) << 40
+                     | static_cast<uint64_t>(textureSlot) << 24
+                     | static_cast<uint64_t>(keys.size()));
+        return true;
+    }
+
+    void RenderQueue::Sort()
+    {
+        runs.clear();
+        if (keys.empty()) { return; }
+
+        scratch.resize(keys.size());
+
+        for (uint32_t shift = ItemBits; shift < 64; shift += 8)
+        {
+            std::array<uint32_t, 256> offsets {};
+            for (const uint64_t key : keys) { ++offsets[(key >> shift) & 0xFF]; }
+
+            // Every key has the same byte here: this pass would not move anything.
+            if (offsets[(keys.front() >> shift) & 0xFF] == keys.size()) { continue; }
+
+            uint32_t total = 0;
+            for (uint32_t& offset : offsets)
+            {
+                const uint32_t count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for (const uint64_t key : keys) { scratch[offsets[(key >> shift) & 0xFF]++] = key; }
+            keys.swap(scratch);
+        }
+
+        for (uint32_t i = 0; i < keys.size(); ++i)
+        {
+            const uint64_t state = (keys[i] >> ItemBits) & STATE_MASK;
+
+            if (!runs.empty() && state == ((keys[runs.back().first] >> ItemBits) & STATE_MASK))
+            {
+                ++runs.back().count;
+                continue;
+            }
+
+            Run& run = runs.emplace_back();
+            run.blend    = static_cast<BlendMode>((state >> 22) & 0x3);
+            run.pipeline = static_cast<uint8_t>((state >> 16) & (MaxPipelines - 1));
+            run.texture  = static_cast<uint16_t>(state & 0xFFFF);
+            run.first    = i;
+            run.count    = 1;
+        }
+    }
+
+    MemoryUsage RenderQueue::Memory() const noexcept
+    {
+        MemoryUsage usage = VectorMemory(keys);
+        usage += VectorMemory(scratch, 0);
+        usage += VectorMemory(runs);
+        usage += VectorMemory(textures);
+        return usage;
+    }
+}
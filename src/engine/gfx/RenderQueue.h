@@ -0,0 +1,90 @@
+#ifndef TERRANENGINE_RENDERQUEUE_H
+#define TERRANENGINE_RENDERQUEUE_H
+
+#include "engine/gfx/BlendMode.h"
+#include "engine/gfx/Texture.h"
+#include "engine/core/MemoryReport.h"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Orders one frame's draw items by a 64-bit sort key, so they are drawn back to front with as few state changes as possible.
+     *
+     * Each item is reduced to a key, most significant bits first:
+     *
+     *     | layer 16 | blend 2 | pipeline 6 | texture 16 | item 24 |
+     *
+     * `layer` is the item's z-level, biased so lower levels sort (and draw) first, i.e. further back. Items on the same level are at the same
+     * depth, so their order does not matter for blending and they are grouped by state instead. `item` is the push order. It keeps the sort
+     * stable and maps each sorted key back to the caller's data.
+     *
+     * ### Sorting.
+     *
+     * `Sort` is an LSD radix sort on the 40 bits above `item`, one byte per pass, and skips any pass where every key has the same byte. Keys
+     * are pushed in item order, so they start sorted on the low bits and each stable pass keeps it that way. A frame where everything shares
+     * a blend mode and pipeline usually takes two passes: texture and layer.
+     *
+     * ### Runs.
+     *
+     * Neighbouring keys with the same blend, pipeline and texture form one `Run`, even across layers, since a single draw call renders its
+     * primitives in order. A run is one draw call.
+     */
+    class RenderQueue
+    {
+    public:
+        static constexpr uint32_t ItemBits     = 24;
+        static constexpr uint32_t MaxItems     = 1u << ItemBits;
+        static constexpr uint32_t MaxTextures  = 1u << 16;
+        static constexpr uint32_t MaxPipelines = 1u << 6;
+
+        struct Run
+        {
+            BlendMode blend    {BlendMode::Alpha};
+            uint8_t   pipeline {0};
+            uint16_t  texture  {0}; // Slot in the texture table; see `TextureAt`.
+            uint32_t  first    {0}; // Into `Keys()`.
+            uint32_t  count    {0};
+        };
+
+        /** Forget the last frame's items and textures, keeping their storage. */
+        void Clear() noexcept;
+
+        /** Slot of `texture` in this frame's table, adding it if new. Returns false when the table is full. */
+        [[nodiscard]] bool TextureSlot(const Texture* texture, uint16_t& slot);
+
+        /** Queue an item as index `Size()`. `pipeline` must be below `MaxPipelines`. Returns false when the queue is full. */
+        bool Push(int32_t layer, BlendMode blend, uint8_t pipeline, uint16_t textureSlot);
+
+        /** Sort the queued keys and split them into runs. */
+        void Sort();
+
+        [[nodiscard]] std::span<const uint64_t> Keys() const noexcept { return keys; }
+        [[nodiscard]] std::span<const Run>      Runs() const noexcept { return runs; }
+        [[nodiscard]] size_t                    Size() const noexcept { return keys.size(); }
+
+        [[nodiscard]] const Texture*                TextureAt(uint16_t slot) const noexcept { return textures[slot]; }
+        [[nodiscard]] std::span<const Texture* const> Textures() const noexcept { return textures; }
+
+        /** Push index of the item a sorted key belongs to. */
+        [[nodiscard]] static uint32_t Item(uint64_t key) noexcept { return static_cast<uint32_t>(key & (MaxItems - 1)); }
+
+        [[nodiscard]] MemoryUsage Memory() const noexcept;
+
+    private:
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> scratch; // Other half of each radix pass.
+        std::vector<Run>      runs;
+
+        std::vector<const Texture*>                  textures;
+        std::unordered_map<const Texture*, uint16_t> textureSlots;
+        const Texture*                               lastTexture {nullptr}; // Most items repeat the previous item's texture.
+        uint16_t                                     lastSlot    {0};
+    };
+}
+
+#endif // TERRANENGINE_RENDERQUEUE_H
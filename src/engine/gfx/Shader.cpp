@@ -21,14 +21,12 @@ namespace TerranEngine
         return stringStream.str();
     }
 
-    GLuint Shader::CompileStage(std::string_view shaderPath, GLenum type)
+    GLuint Shader::CompileStage(std::string_view source, GLenum type, std::string_view name)
     {
-        std::string source = LoadFile(shaderPath);
-        if (source.empty()) { return 0; }
-
         GLuint id = glCreateShader(type);
-        const char* pointer = source.c_str();
-        glShaderSource(id, 1, &pointer, nullptr);
+        const char* pointer = source.data();
+        const GLint length  = static_cast<GLint>(source.size());
+        glShaderSource(id, 1, &pointer, &length);
         glCompileShader(id);
 
         GLint compiled = 0;
@@ -37,7 +35,7 @@ namespace TerranEngine
         {
             char log[512];
             glGetShaderInfoLog(id, 512, nullptr, log);
-            TE_LOG_ERROR("Shader compilation failed ('{}') failed: {}", shaderPath, log);
+            TE_LOG_ERROR("Shader compilation ('{}') failed: {}", name, log);
             glDeleteShader(id);
             return 0;
         }
@@ -45,17 +43,30 @@ namespace TerranEngine
         return id;
     }
 
-    Shader::Shader(std::string_view vertPath, std::string_view fragPath)
+    void Shader::Link(std::string_view vertSource, std::string_view fragSource, std::string_view name)
     {
-        GLuint vertShader = CompileStage(vertPath, GL_VERTEX_SHADER);
-        GLuint fragShader = CompileStage(fragPath, GL_FRAGMENT_SHADER);
-        if (!vertShader || !fragShader) { return; }
+        if (vertSource.empty() || fragSource.empty()) { return; }
+
+        GLuint vertShader = CompileStage(vertSource, GL_VERTEX_SHADER, name);
+        GLuint fragShader = CompileStage(fragSource, GL_FRAGMENT_SHADER, name);
+        if (!vertShader || !fragShader)
+        {
+            glDeleteShader(vertShader);
+            glDeleteShader(fragShader);
+            return;
+        }
 
         programID = glCreateProgram();
         glAttachShader(programID, vertShader);
         glAttachShader(programID, fragShader);
+
+        // Without the hint some drivers only hand out a binary after the program's first use.
+        glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(programID);
 
+        glDeleteShader(vertShader);
+        glDeleteShader(fragShader);
+
         GLint linked = 0;
         glGetProgramiv(programID, GL_LINK_STATUS, &linked);
         if (!linked)
@@ -63,13 +74,56 @@ namespace TerranEngine
             char log[512];
             glGetProgramInfoLog(programID, 512, nullptr, log);
             Release();
-            TE_LOG_ERROR("Linking Shader-Program ('{} | {}') failed: {}", vertPath, fragPath, log);
+            TE_LOG_ERROR("Linking Shader-Program ('{}') failed: {}", name, log);
+            return;
         }
 
-        glDeleteShader(vertShader);
-        glDeleteShader(fragShader);
+        TE_LOG_INFO("Shader-Program created: {}", name);
+    }
+
+    Shader::Shader(std::string_view vertPath, std::string_view fragPath)
+    {
+        const std::string vertSource = LoadFile(vertPath);
+        const std::string fragSource = LoadFile(fragPath);
+
+        Link(vertSource, fragSource, std::string {vertPath} + " | " + std::string {fragPath});
+    }
+
+    Shader Shader::FromSource(std::string_view vertSource, std::string_view fragSource, std::string_view name)
+    {
+        Shader shader;
+        shader.Link(vertSource, fragSource, name);
+        return shader;
+    }
+
+    Shader Shader::FromBinary(GLenum format, std::span<const std::byte> binary)
+    {
+        Shader shader;
+        shader.programID = glCreateProgram();
+        glProgramBinary(shader.programID, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint linked = 0;
+        glGetProgramiv(shader.programID, GL_LINK_STATUS, &linked);
+        if (!linked) { shader.Release(); }
+
+        return shader;
+    }
+
+    bool Shader::GetBinary(GLenum& format, std::vector<std::byte>& binary) const
+    {
+        if (!programID) { return false; }
+
+        GLint length = 0;
+        glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) { return false; }
+
+        binary.resize(static_cast<size_t>(length));
+
+        GLsizei written = 0;
+        glGetProgramBinary(programID, length, &written, &format, binary.data());
+        binary.resize(static_cast<size_t>(written));
 
-        TE_LOG_INFO("Shader-Program created: {} | {}", vertPath, fragPath);
+        return written > 0;
     }
 
     Shader::Shader(Shader&& otherShader) noexcept : programID(otherShader.programID), uniformLocationCache(std::move(otherShader.uniformLocationCache)) { otherShader.programID = 0; }
@@ -3,9 +3,12 @@
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <span>
 #include <unordered_map>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace TerranEngine
 {
@@ -21,6 +24,15 @@ namespace TerranEngine
         Shader(const Shader&)           = delete;
         Shader& operator=(const Shader&) = delete;
 
+        /** Compile and link a program from GLSL sources. `name` only labels log messages. Check `ID()` for success. */
+        [[nodiscard]] static Shader FromSource(std::string_view vertSource, std::string_view fragSource, std::string_view name);
+
+        /** Load a program saved with `GetBinary`. Returns an empty Shader if the driver rejects it, e.g. after a driver update. */
+        [[nodiscard]] static Shader FromBinary(GLenum format, std::span<const std::byte> binary);
+
+        /** The linked program in the driver's own binary format. Returns false if there is no program or the driver provides no binary. */
+        bool GetBinary(GLenum& format, std::vector<std::byte>& binary) const;
+
         void Use() const noexcept { glUseProgram(programID); }
 
         void SetUniform(std::string_view uniformName, int    value)             const noexcept;
@@ -38,7 +50,8 @@ namespace TerranEngine
         mutable std::unordered_map<std::string, GLint> uniformLocationCache;
 
         [[nodiscard]] GLint GetLocation(std::string_view uniformName) const noexcept;
-        static GLuint CompileStage(std::string_view shaderPath, GLenum type);
+        void Link(std::string_view vertSource, std::string_view fragSource, std::string_view name);
+        static GLuint CompileStage(std::string_view source, GLenum type, std::string_view name);
         void Release() noexcept;
     };
 }
@@ -0,0 +1,209 @@
+#include "engine/gfx/ShaderLibrary.h"
+
+#include "engine/core/Log.h"
+#include "engine/gfx/EmbeddedShaders.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TerranEngine
+{
+    static constexpr char     CACHE_MAGIC[4]    = {'T', 'E', 'P', 'B'};
+    static constexpr uint32_t CACHE_VERSION     = 1;
+    static constexpr size_t   CACHE_HEADER_SIZE = sizeof(CACHE_MAGIC) + sizeof(uint32_t) * 2 + sizeof(uint64_t); // Magic, version, format, key.
+
+    struct LibraryState
+    {
+        std::unordered_map<std::string, std::weak_ptr<const Shader>> programs; // By "vert | frag".
+
+        std::string shaderDirectory {"../../assets/shaders"};
+        std::string cacheDirectory  {"shader_cache"};
+
+        std::string driver;                // Vendor, renderer and version; part of every cache key.
+        bool        driverQueried {false};
+        bool        binaryFormats {false}; // Whether the driver can save programs at all.
+    };
+
+    static LibraryState& State()
+    {
+        static LibraryState state;
+        return state;
+    }
+
+    /** 64-bit FNV-1a, continuing from `hash`. */
+    static uint64_t Hash(uint64_t hash, std::string_view bytes) noexcept
+    {
+        for (const char byte : bytes) { hash = (hash ^ static_cast<uint8_t>(byte)) * 0x100000001B3ull; }
+        return hash;
+    }
+
+    static std::string_view GLString(GLenum name)
+    {
+        const GLubyte* string = glGetString(name);
+        return string ? std::string_view {reinterpret_cast<const char*>(string)} : std::string_view {};
+    }
+
+    static bool ReadFile(const std::filesystem::path& filePath, std::string& contents)
+    {
+        std::ifstream file(filePath, std::ios::in | std::ios::binary);
+        if (!file) { return false; }
+
+        std::ostringstream stringStream;
+        stringStream << file.rdbuf();
+        contents = stringStream.str();
+        return true;
+    }
+
+    /** Source of the stage `name`: the file in the shader directory if present, else the embedded copy. */
+    static bool LoadStage(const LibraryState& state, std::string_view name, std::string& source)
+    {
+        if (ReadFile(std::filesystem::path {state.shaderDirectory} / name, source)) { return true; }
+
+        for (const EmbeddedShaders::Entry& entry : EmbeddedShaders::Entries)
+        {
+            if (entry.name == name)
+            {
+                source = entry.source;
+                return true;
+            }
+        }
+
+        TE_LOG_ERROR("ShaderLibrary: No shader '{}' in '{}' or embedded.", name, state.shaderDirectory);
+        return false;
+    }
+
+    template<typename T>
+    static T ReadValue(const char* bytes) noexcept
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static void WriteValue(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static Shader LoadCached(const std::filesystem::path& cachePath, uint64_t key)
+    {
+        std::string contents;
+        if (!ReadFile(cachePath, contents) || contents.size() <= CACHE_HEADER_SIZE) { return {}; }
+
+        const char* header = contents.data();
+        if (std::memcmp(header, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+         || ReadValue<uint32_t>(header + 4) != CACHE_VERSION
+         || ReadValue<uint64_t>(header + 12) != key)
+        {
+            return {};
+        }
+
+        const auto* binary = reinterpret_cast<const std::byte*>(contents.data() + CACHE_HEADER_SIZE);
+        return Shader::FromBinary(static_cast<GLenum>(ReadValue<uint32_t>(header + 8)), {binary, contents.size() - CACHE_HEADER_SIZE});
+    }
+
+    static void SaveCached(const std::filesystem::path& cachePath, uint64_t key, const Shader& shader)
+    {
+        GLenum                 format = 0;
+        std::vector<std::byte> binary;
+        if (!shader.GetBinary(format, binary)) { return; }
+
+        std::string out;
+        out.reserve(CACHE_HEADER_SIZE + binary.size());
+        out.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        WriteValue<uint32_t>(out, CACHE_VERSION);
+        WriteValue<uint32_t>(out, static_cast<uint32_t>(format));
+        WriteValue<uint64_t>(out, key);
+        out.append(reinterpret_cast<const char*>(binary.data()), binary.size());
+
+        std::error_code error;
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+
+        // Written aside and renamed into place, so another instance never reads half a file.
+        std::filesystem::path temporaryPath = cachePath;
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream stream {temporaryPath, std::ios::binary | std::ios::trunc};
+            if (!stream || !stream.write(out.data(), static_cast<std::streamsize>(out.size())))
+            {
+                TE_LOG_WARN("ShaderLibrary: Failed to write program cache '{}'.", temporaryPath.string());
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error) { TE_LOG_WARN("ShaderLibrary: Failed to write program cache '{}'.", cachePath.string()); }
+    }
+
+    std::shared_ptr<const Shader> ShaderLibrary::Acquire(std::string_view vertName, std::string_view fragName)
+    {
+        LibraryState& state = State();
+
+        const std::string name = std::string {vertName} + " | " + std::string {fragName};
+
+        // Weak, so a program is deleted with its last user rather than at static destruction, after the context is gone.
+        std::weak_ptr<const Shader>& shared = state.programs[name];
+        if (std::shared_ptr<const Shader> program = shared.lock()) { return program; }
+
+        std::string vertSource;
+        std::string fragSource;
+        if (!LoadStage(state, vertName, vertSource) || !LoadStage(state, fragName, fragSource)) { return std::make_shared<const Shader>(); }
+
+        if (!state.driverQueried)
+        {
+            GLint formatCount = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+            state.driver        = std::string {GLString(GL_VENDOR)} + '\n' + std::string {GLString(GL_RENDERER)} + '\n' + std::string {GLString(GL_VERSION)};
+            state.binaryFormats = formatCount > 0;
+            state.driverQueried = true;
+        }
+
+        // A NUL between the parts, which no source contains, so moving text from one part to the next changes the key.
+        const std::string_view separator {"", 1};
+
+        uint64_t key = 0xCBF29CE484222325ull;
+        key = Hash(Hash(key, vertSource), separator);
+        key = Hash(Hash(key, fragSource), separator);
+        key = Hash(key, state.driver);
+
+        std::filesystem::path cachePath;
+        if (state.binaryFormats && !state.cacheDirectory.empty())
+        {
+            char hex[16];
+            char* end = std::to_chars(hex, hex + sizeof(hex), key, 16).ptr;
+            cachePath = std::filesystem::path {state.cacheDirectory} / (std::string {hex, end} + ".glprog");
+        }
+
+        Shader shader;
+        if (!cachePath.empty()) { shader = LoadCached(cachePath, key); }
+
+        if (shader.ID())
+        {
+            TE_LOG_INFO("Shader-Program loaded from cache: {}", name);
+        }
+        else
+        {
+            shader = Shader::FromSource(vertSource, fragSource, name);
+            if (shader.ID() && !cachePath.empty()) { SaveCached(cachePath, key, shader); }
+        }
+
+        auto program = std::make_shared<const Shader>(std::move(shader));
+
+        // A failed program is not kept, so the next caller tries again (e.g. after fixing the file).
+        if (program->ID()) { shared = program; }
+        return program;
+    }
+
+    void ShaderLibrary::SetShaderDirectory(std::string_view directory) { State().shaderDirectory = directory; }
+    void ShaderLibrary::SetCacheDirectory(std::string_view directory)  { State().cacheDirectory  = directory; }
+}
@@ -0,0 +1,42 @@
+#ifndef TERRANENGINE_SHADERLIBRARY_H
+#define TERRANENGINE_SHADERLIBRARY_H
+
+#include "engine/gfx/Shader.h"
+
+#include <memory>
+#include <string_view>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Shares compiled `Shader` programs between renderers, and keeps linked programs on disk so later runs skip compilation.
+     *
+     * Programs are named by their stage files, e.g. `Acquire("sprite.vert", "sprite.frag")`. A stage is read from the shader directory when the
+     * file is there, so shaders can be edited without a rebuild, and otherwise from the copy compiled into the engine by
+     * `cmake/EmbedShaders.cmake`.
+     *
+     * ### Program binary cache.
+     *
+     * A newly linked program is saved with `glGetProgramBinary` as `<cache directory>/<key>.glprog`. The key hashes both sources with the GL
+     * vendor, renderer and version strings, so an edited shader or an updated driver misses the cache rather than loading a stale binary. A
+     * binary the driver still rejects is recompiled and overwritten. Drivers reporting no binary formats skip the cache.
+     *
+     * Like `QuadIndexBuffer`, a program lives as long as someone holds its pointer. Use from the GL context's thread only.
+     */
+    class ShaderLibrary
+    {
+    public:
+        ShaderLibrary() = delete;
+
+        /** The program linking `vertName` and `fragName`, shared with every other holder. Points to an empty Shader (ID 0) on failure. */
+        [[nodiscard]] static std::shared_ptr<const Shader> Acquire(std::string_view vertName, std::string_view fragName);
+
+        /** Directory stage files are read from before falling back to the embedded copies. Default `../../assets/shaders`. */
+        static void SetShaderDirectory(std::string_view directory);
+
+        /** Directory program binaries are kept in, created on first save. Empty disables the cache. Default `shader_cache`. */
+        static void SetCacheDirectory(std::string_view directory);
+    };
+}
+
+#endif // TERRANENGINE_SHADERLIBRARY_H
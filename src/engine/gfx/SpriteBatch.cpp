@@ -2,22 +2,19 @@
 
 #include "engine/core/Log.h"
 
+#include <cstring>
+#include <string>
+
 namespace TerranEngine
 {
-    static constexpr uint16_t INDICES_PER_QUAD  {6};
     static constexpr uint16_t VERTICES_PER_QUAD {4};
+    static constexpr size_t   QUAD_BYTES        {VERTICES_PER_QUAD * sizeof(Vertex)};
 
     SpriteBatch::SpriteBatch(size_t initialCapacity)
+        : initialQuads(initialCapacity)
     {
-        vertices.reserve(initialCapacity * VERTICES_PER_QUAD);
-        indices.reserve(initialCapacity * VERTICES_PER_QUAD);
-
         glCreateVertexArrays(1, &vao);
-        glCreateBuffers(1, &vbo);
-        glCreateBuffers(1, &ebo);
-
-        glVertexArrayVertexBuffer(vao, 0, vbo, 0, sizeof(Vertex));
-        glVertexArrayElementBuffer(vao, ebo);
+        glVertexArrayElementBuffer(vao, indices->ID());
 
         // Position Attribute (X, Y)
         glEnableVertexArrayAttrib(vao, 0);
@@ -40,66 +37,77 @@ namespace TerranEngine
         glVertexArrayAttribBinding(vao, 3, 0);
     }
 
-    void SpriteBatch::Begin(const Texture& atlas, const Camera2D& camera)
+    void SpriteBatch::Begin(const Camera2D& camera)
     {
-        currentTexture = &atlas;
-        shader.Use();
-        shader.SetUniform("uTexture0", 0);
-        shader.SetUniform("uTransform", camera.viewProjection);
-
-        vertices.clear();
-        indices.clear();
-        quadCount = 0;
+        transform = camera.viewProjection;
+
+        // Waits here, rather than mid-frame, if the GPU is still drawing from this region.
+        mapped       = reinterpret_cast<Vertex*>(vertexStream.Begin(initialQuads * QUAD_BYTES));
+        quadCapacity = mapped ? vertexStream.RegionBytes() / QUAD_BYTES : 0;
+        quadCount    = 0;
     }
 
     void SpriteBatch::SubmitQuad(const Vertex* quadVertices)
     {
-        Grow(quadCount + 1);
-
-        uint16_t baseIndex = static_cast<uint16_t>(vertices.size());
-        vertices.insert(vertices.end(), quadVertices, quadVertices + 4);
-
-        indices.push_back(baseIndex + 0);
-        indices.push_back(baseIndex + 1);
-        indices.push_back(baseIndex + 2);
-        indices.push_back(baseIndex + 0);
-        indices.push_back(baseIndex + 2);
-        indices.push_back(baseIndex + 3);
+        if (!Reserve(1)) return;
 
+        std::memcpy(mapped + quadCount * VERTICES_PER_QUAD, quadVertices, QUAD_BYTES);
         ++quadCount;
     }
 
-    void SpriteBatch::End()
+    Vertex* SpriteBatch::AllocateQuads(size_t count)
     {
-        if (!quadCount) return;
+        if (!Reserve(count)) return nullptr;
 
-        glNamedBufferData(vbo, vertices.size() * sizeof(Vertex), vertices.data(), GL_DYNAMIC_DRAW);
-        glNamedBufferData(ebo, indices.size() * sizeof(uint16_t), indices.data(), GL_DYNAMIC_DRAW);
+        Vertex* quads = mapped + quadCount * VERTICES_PER_QUAD;
+        quadCount += count;
+        return quads;
+    }
 
-        currentTexture->Bind(0);
-        shader.Use();
+    void SpriteBatch::Draw(const Texture& texture, size_t firstQuad, size_t count)
+    {
+        if (!count || !mapped) return;
+
+        texture.Bind(0);
+        shader->Use();
+        shader->SetUniform("uTexture0", 0);
+        shader->SetUniform("uTransform", transform);
+        glVertexArrayVertexBuffer(vao, 0, vertexStream.Buffer(), static_cast<GLintptr>(vertexStream.Offset()), sizeof(Vertex));
         glBindVertexArray(vao);
 
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr);
+        QuadIndexBuffer::Draw(count, firstQuad);
+    }
+
+    void SpriteBatch::End()
+    {
+        if (!quadCount || !mapped) return;
+
+        vertexStream.End();
+        lastQuadCount = quadCount;
+        mapped = nullptr; // Ends the frame: nothing more is written or drawn until the next `Begin`.
     }
 
-    void SpriteBatch::Grow(size_t requiredVertices)
+    bool SpriteBatch::Reserve(size_t count)
     {
-        if (requiredVertices <= vertices.capacity() / VERTICES_PER_QUAD) return;
+        if (quadCount + count <= quadCapacity) return true;
+        if (!mapped) return false;
 
-        size_t newCapacity = vertices.capacity() ? vertices.capacity() * 2 : 1024;
-        while (newCapacity < requiredVertices * VERTICES_PER_QUAD) { newCapacity *= 2; }
+        // On failure the current region is untouched, so the quads already written can still be drawn.
+        Vertex* grown = reinterpret_cast<Vertex*>(vertexStream.Grow((quadCount + count) * QUAD_BYTES, quadCount * QUAD_BYTES));
+        if (!grown) return false;
 
-        vertices.reserve(newCapacity);
-        indices.reserve((newCapacity / VERTICES_PER_QUAD) * INDICES_PER_QUAD);
+        mapped       = grown;
+        quadCapacity = vertexStream.RegionBytes() / QUAD_BYTES;
+        return true;
     }
 
-    void SpriteBatch::Reset() noexcept { vertices.clear(); indices.clear(); quadCount = 0; }
+    void SpriteBatch::ReportMemory(MemoryReport& report, std::string_view owner) const
+    {
+        report.Add(std::string {owner} + "/gpu vertices", { lastQuadCount * QUAD_BYTES, vertexStream.Bytes() });
+    }
 
     SpriteBatch::~SpriteBatch()
     {
         glDeleteVertexArrays(1, &vao);
-        glDeleteBuffers(1, &vbo);
-        glDeleteBuffers(1, &ebo);
     }
 }
\ No newline at end of file
@@ -1,13 +1,18 @@
 #ifndef TERRANENGINE_SPRITEBATCH_H
 #define TERRANENGINE_SPRITEBATCH_H
 
-#include "engine/gfx/Shader.h"
+#include "engine/gfx/QuadIndexBuffer.h"
+#include "engine/gfx/ShaderLibrary.h"
+#include "engine/gfx/StreamBuffer.h"
 #include "engine/gfx/Texture.h"
 #include "engine/ecs/components/Components.h"
+#include "engine/core/MemoryReport.h"
 
 #include <glm/glm.hpp>
 #include <glad/gl.h>
-#include <vector>
+
+#include <memory>
+#include <string_view>
 
 namespace TerranEngine
 {
@@ -20,33 +25,56 @@ namespace TerranEngine
         float     depth;
     };
 
+    /**
+     * @brief Collects a frame's textured quads in draw order and draws them in ranges, one call per range.
+     *
+     * Quads are written straight into a persistently mapped `StreamBuffer`, so a frame's vertices are never copied on the CPU or re-uploaded by
+     * the driver. Every quad uses the same index pattern, so indices come from the shared `QuadIndexBuffer`, which also splits ranges larger
+     * than 16-bit indices can address into several draws.
+     *
+     * A frame is `Begin`, every quad appended, one `Draw` per range of quads sharing a texture, then `End`. Quads must not be appended after
+     * the first `Draw`, since growing the buffer would move the quads already drawn from.
+     */
     class SpriteBatch
     {
     public:
         explicit SpriteBatch(size_t initialCapacity = 1024);
         ~SpriteBatch();
 
-        void Begin(const Texture& atlas, const Camera2D& camera);
+        void Begin(const Camera2D& camera);
         void SubmitQuad(const Vertex* vertices);
+
+        /** Append `count` quads and return their `count * 4` vertices for the caller to fill in before the first `Draw`. Returns nullptr, and
+         *  appends nothing, if the stream buffer could not make room. */
+        [[nodiscard]] Vertex* AllocateQuads(size_t count);
+
+        /** Draw `count` quads from quad `firstQuad` of this frame, sampling `texture`. */
+        void Draw(const Texture& texture, size_t firstQuad, size_t count);
         void End();
-        void Reset() noexcept;
 
         [[nodiscard]] size_t SpriteCount() const noexcept { return quadCount; }
 
+        /** Adds the GPU vertex ring as `<owner>/gpu vertices`, counting the vertices of the last frame as used. */
+        void ReportMemory(MemoryReport& report, std::string_view owner) const;
+
     private:
-        void Grow(size_t requiredVertices);
+        /** Make room for `count` more quads, growing the stream buffer if the current region is full. Returns false if it cannot. */
+        [[nodiscard]] bool Reserve(size_t count);
 
         GLuint vao {0};
-        GLuint vbo {0};
-        GLuint ebo {0};
 
-        std::vector<Vertex> vertices;
-        std::vector<uint16_t> indices;
+        std::shared_ptr<const QuadIndexBuffer> indices {QuadIndexBuffer::Acquire()};
+        std::shared_ptr<const Shader>          shader  {ShaderLibrary::Acquire("sprite.vert", "sprite.frag")};
+
+        StreamBuffer vertexStream;
+        Vertex*      mapped        {nullptr}; // Current region of `vertexStream`.
+        size_t       quadCapacity  {0};       // Quads that fit in the current region.
+        size_t       initialQuads  {0};
 
-        const Texture* currentTexture {nullptr};
-        Shader shader {"../../assets/shaders/sprite.vert", "../../assets/shaders/sprite.frag"};
+        glm::mat4 transform {1.0f};
 
-        size_t quadCount {0};
+        size_t quadCount     {0};
+        size_t lastQuadCount {0};
     };
 }
 
@@ -0,0 +1,126 @@
+#include "engine/gfx/SpriteInstanceBatch.h"
+
+#include <cstddef>
+#include <string>
+
+namespace TerranEngine
+{
+    SpriteInstanceBatch::SpriteInstanceBatch(size_t initialCapacity)
+        : initialInstances(initialCapacity)
+    {
+        glCreateVertexArrays(1, &vao);
+
+        // Every attribute advances once per instance.
+        glVertexArrayBindingDivisor(vao, 0, 1);
+
+        auto attribute = [this](GLuint location, GLint components, GLenum type, GLboolean normalised, size_t offset)
+        {
+            glEnableVertexArrayAttrib(vao, location);
+            glVertexArrayAttribFormat(vao, location, components, type, normalised, static_cast<GLuint>(offset));
+            glVertexArrayAttribBinding(vao, location, 0);
+        };
+
+        attribute(0, 2, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, position));
+        attribute(1, 2, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, size));
+        attribute(2, 2, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, anchor));
+        attribute(3, 1, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, rotation));
+        attribute(4, 1, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, depth));
+        attribute(5, 4, GL_FLOAT,         GL_FALSE, offsetof(SpriteInstance, uvRect));
+        attribute(6, 4, GL_UNSIGNED_BYTE, GL_TRUE,  offsetof(SpriteInstance, tint));
+
+        // Integer, so the layer reaches the shader exactly.
+        glEnableVertexArrayAttrib(vao, 7);
+        glVertexArrayAttribIFormat(vao, 7, 1, GL_UNSIGNED_INT, static_cast<GLuint>(offsetof(SpriteInstance, layer)));
+        glVertexArrayAttribBinding(vao, 7, 0);
+    }
+
+    void SpriteInstanceBatch::Begin(const Camera2D& camera)
+    {
+        transform = camera.viewProjection;
+
+        mapped           = reinterpret_cast<SpriteInstance*>(instanceStream.Begin(initialInstances * sizeof(SpriteInstance)));
+        instanceCapacity = mapped ? instanceStream.RegionBytes() / sizeof(SpriteInstance) : 0;
+        instanceCount    = 0;
+    }
+
+    void SpriteInstanceBatch::Submit(const SpriteInstance& instance)
+    {
+        if (!Reserve(1)) return;
+
+        mapped[instanceCount++] = instance;
+    }
+
+    SpriteInstance* SpriteInstanceBatch::AllocateInstances(size_t count)
+    {
+        if (!Reserve(count)) return nullptr;
+
+        SpriteInstance* allocated = mapped + instanceCount;
+        instanceCount += count;
+        return allocated;
+    }
+
+    bool SpriteInstanceBatch::Reserve(size_t count)
+    {
+        if (instanceCount + count <= instanceCapacity) return true;
+        if (!mapped) return false;
+
+        // On failure the current region is untouched, so the instances already written can still be drawn.
+        auto* grown = reinterpret_cast<SpriteInstance*>(instanceStream.Grow((instanceCount + count) * sizeof(SpriteInstance), instanceCount * sizeof(SpriteInstance)));
+        if (!grown) return false;
+
+        mapped           = grown;
+        instanceCapacity = instanceStream.RegionBytes() / sizeof(SpriteInstance);
+        return true;
+    }
+
+    void SpriteInstanceBatch::Draw(const Texture& texture, size_t first, size_t count)
+    {
+        if (!count || !mapped) return;
+
+        texture.Bind(0);
+        shader->Use();
+        shader->SetUniform("uTexture0", 0);
+        DrawInstances(*shader, first, count);
+    }
+
+    void SpriteInstanceBatch::Draw(const TextureArray& array, size_t first, size_t count)
+    {
+        if (!count || !mapped) return;
+
+        if (!arrayShader) { arrayShader = ShaderLibrary::Acquire("sprite_instanced.vert", "sprite_array.frag"); }
+
+        array.Bind(0);
+        arrayShader->Use();
+        arrayShader->SetUniform("uTextures", 0);
+        DrawInstances(*arrayShader, first, count);
+    }
+
+    void SpriteInstanceBatch::DrawInstances(const Shader& program, size_t first, size_t count)
+    {
+        program.SetUniform("uTransform", transform);
+        glVertexArrayVertexBuffer(vao, 0, instanceStream.Buffer(), static_cast<GLintptr>(instanceStream.Offset()), sizeof(SpriteInstance));
+        glBindVertexArray(vao);
+
+        // The base instance offsets the per-instance attributes, so every range reads from the same binding.
+        glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count), static_cast<GLuint>(first));
+    }
+
+    void SpriteInstanceBatch::End()
+    {
+        if (!instanceCount || !mapped) return;
+
+        instanceStream.End();
+        lastInstanceCount = instanceCount;
+        mapped = nullptr; // Ends the frame: nothing more is written or drawn until the next `Begin`.
+    }
+
+    void SpriteInstanceBatch::ReportMemory(MemoryReport& report, std::string_view owner) const
+    {
+        report.Add(std::string {owner} + "/gpu instances", { lastInstanceCount * sizeof(SpriteInstance), instanceStream.Bytes() });
+    }
+
+    SpriteInstanceBatch::~SpriteInstanceBatch()
+    {
+        glDeleteVertexArrays(1, &vao);
+    }
+}
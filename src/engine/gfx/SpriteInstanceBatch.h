@@ -0,0 +1,94 @@
+#ifndef TERRANENGINE_SPRITEINSTANCEBATCH_H
+#define TERRANENGINE_SPRITEINSTANCEBATCH_H
+
+#include "engine/gfx/ShaderLibrary.h"
+#include "engine/gfx/StreamBuffer.h"
+#include "engine/gfx/Texture.h"
+#include "engine/gfx/TextureArray.h"
+#include "engine/ecs/components/Components.h"
+#include "engine/core/MemoryReport.h"
+
+#include <glm/glm.hpp>
+#include <glad/gl.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace TerranEngine
+{
+    /** One sprite, expanded into a quad by `sprite_instanced.vert`. 56 bytes, against 144 bytes of `Vertex` and 24 bytes of indices per quad. */
+    struct SpriteInstance
+    {
+        glm::vec2 position; // World position of the anchor.
+        glm::vec2 size;     // World size, scale applied.
+        glm::vec2 anchor;   // Point of the quad (0-1) placed at `position` and rotated about.
+        float     rotation; // Radians.
+        float     depth;
+        glm::vec4 uvRect;   // UV min, UV size.
+        uint32_t  tint;     // RGBA-8, red in the lowest byte.
+        uint32_t  layer;    // `TextureArray` layer; unused when drawing a single Texture.
+    };
+
+    static_assert(sizeof(SpriteInstance) == 56, "SpriteInstance is uploaded as is; keep it tightly packed.");
+
+    /**
+     * @brief Collects a frame's `SpriteInstance`s in draw order and draws them in ranges with instanced calls.
+     *
+     * Instances are written straight into a persistently mapped `StreamBuffer` and read as per-instance attributes. Each instance is drawn as a
+     * 4-vertex triangle strip whose corners come from `gl_VertexID`, so no vertex or index buffer is needed.
+     *
+     * A range drawn from a `TextureArray` samples it at each instance's layer, so sprites of every Texture in the array share one call. As with
+     * `SpriteBatch`, instances must not be appended after the first `Draw` of a frame.
+     */
+    class SpriteInstanceBatch
+    {
+    public:
+        explicit SpriteInstanceBatch(size_t initialCapacity = 1024);
+        ~SpriteInstanceBatch();
+
+        SpriteInstanceBatch(const SpriteInstanceBatch&)            = delete;
+        SpriteInstanceBatch& operator=(const SpriteInstanceBatch&) = delete;
+
+        void Begin(const Camera2D& camera);
+        void Submit(const SpriteInstance& instance);
+
+        /** Append `count` instances and return them for the caller to fill in before the first `Draw`. Returns nullptr, and appends nothing, if
+         *  the stream buffer could not make room. */
+        [[nodiscard]] SpriteInstance* AllocateInstances(size_t count);
+
+        /** Draw `count` instances from instance `first` of this frame, sampling `texture`, or `array` at each instance's layer. */
+        void Draw(const Texture& texture, size_t first, size_t count);
+        void Draw(const TextureArray& array, size_t first, size_t count);
+        void End();
+
+        [[nodiscard]] size_t InstanceCount() const noexcept { return instanceCount; }
+
+        /** Adds the GPU instance ring as `<owner>/gpu instances`, counting the instances of the last frame as used. */
+        void ReportMemory(MemoryReport& report, std::string_view owner) const;
+
+    private:
+        /** Make room for `count` more instances, growing the stream buffer if the current region is full. Returns false if it cannot. */
+        [[nodiscard]] bool Reserve(size_t count);
+
+        void DrawInstances(const Shader& program, size_t first, size_t count);
+
+    private:
+        GLuint vao {0};
+
+        StreamBuffer    instanceStream;
+        SpriteInstance* mapped           {nullptr}; // Current region of `instanceStream`.
+        size_t          instanceCapacity {0};       // Instances that fit in the current region.
+        size_t          initialInstances {0};
+
+        glm::mat4 transform {1.0f};
+
+        std::shared_ptr<const Shader> shader      {ShaderLibrary::Acquire("sprite_instanced.vert", "sprite.frag")};
+        std::shared_ptr<const Shader> arrayShader; // Acquired by the first `TextureArray` draw.
+
+        size_t instanceCount     {0};
+        size_t lastInstanceCount {0};
+    };
+}
+
+#endif // TERRANENGINE_SPRITEINSTANCEBATCH_H
@@ -1,107 +1,292 @@
 #include "engine/gfx/SpriteRenderer.h"
 
+#include "engine/core/Log.h"
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
 #include <cmath>
 
-inline glm::vec2 RotateVec2(const glm::vec2& vector, float radians) noexcept
-{
-    const float cos = std::cos(radians);
-    const float sin = std::sin(radians);
-    return { vector.x * cos - vector.y * sin, vector.x * sin + vector.y * cos };
-}
-
 namespace TerranEngine
 {
+    static constexpr size_t QUAD_GROUP = 64; // CPU-expanded sprites gathered per `ExpandQuads` call.
+
+    /** RGBA-8 with red in the lowest byte, matching a `GL_UNSIGNED_BYTE` x 4 normalised attribute. */
+    static uint32_t PackColour(const glm::vec4& colour) noexcept
+    {
+        auto channel = [](float value) noexcept { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return channel(colour.x) | channel(colour.y) << 8 | channel(colour.z) << 16 | channel(colour.w) << 24;
+    }
+
+    /** Whether `colour` survives `PackColour` unchanged, i.e. has no overbright or negative channel. */
+    static bool FitsRGBA8(const glm::vec4& colour) noexcept
+    {
+        return colour.x >= 0.0f && colour.x <= 1.0f && colour.y >= 0.0f && colour.y <= 1.0f
+            && colour.z >= 0.0f && colour.z <= 1.0f && colour.w >= 0.0f && colour.w <= 1.0f;
+    }
+
+    /** Conservative test of a sprite's world-space quad against the camera bounds. Exact when unrotated, bounding circle otherwise. */
+    static bool IsVisible(const Transform2D& transform, const Sprite& sprite, const Camera2D& camera) noexcept
+    {
+        // Every corner lies at `position + rotate((corner - anchor) * scaledSize)`, so the anchor alone determines the extent.
+        const glm::vec2 scaledSize = sprite.size * transform.scale;
+
+        glm::vec2 minimum;
+        glm::vec2 maximum;
+
+        if (transform.rotation == 0.0f)
+        {
+            const glm::vec2 a = transform.position - sprite.anchor * scaledSize;
+            const glm::vec2 b = transform.position + (1.0f - sprite.anchor) * scaledSize;
+            minimum = glm::min(a, b);
+            maximum = glm::max(a, b);
+        }
+        else
+        {
+            const float radius = glm::length(glm::max(glm::abs(sprite.anchor), glm::abs(1.0f - sprite.anchor)) * glm::abs(scaledSize));
+            minimum = transform.position - radius;
+            maximum = transform.position + radius;
+        }
+
+        return maximum.x >= camera.viewMin.x && minimum.x <= camera.viewMax.x && maximum.y >= camera.viewMin.y && minimum.y <= camera.viewMax.y;
+    }
+
+    void SpriteRenderer::Bind(World& world)
+    {
+        world.BindQuery(cameras);
+        world.BindQuery(sprites);
+        world.BindQuery(emitters);
+    }
+
     void SpriteRenderer::Update(World& world, float)
     {
+        Bind(world);
+
         Camera2D* currentCamera = nullptr;
-        world.ForEach<Camera2D>([&](Entity, Camera2D& camera)
+        cameras.ForEach([&](Entity, Camera2D& camera)
         {
             if (!currentCamera || camera.primary) { currentCamera = &camera; }
         });
 
         if (!currentCamera) { return; }
 
-        // 1. Push the sprite quads for each component into the correct batch.
-        world.ForEach<Transform2D, Sprite>([this, currentCamera](Entity, Transform2D& transform, Sprite& sprite)
+        culledCount = 0;
+        queueFull   = false;
+        queue.Clear();
+        items.clear();
+
+        // 1. Queue every visible sprite.
+        sprites.ForEach([this, currentCamera](Entity, Transform2D& transform, Sprite& sprite)
         {
             if (!sprite.texture) { return; }
+            if (!IsVisible(transform, sprite, *currentCamera)) { ++culledCount; return; }
+
+            // Instances pack their tint to RGBA-8, so tints outside [0, 1] (e.g. overbright) keep their float tint on the quad pipeline.
+            const bool     asInstance = instanced && FitsRGBA8(sprite.tint);
+            const int      layer      = asInstance && textureArray ? textureArray->Layer(sprite.texture) : -1;
+            const Pipeline pipeline   = !asInstance ? Quads : layer >= 0 ? ArrayInstances : Instances;
+
+            // Resolved here, where the table may grow, so workers only ever read UVs.
+            const glm::vec4 uvRect = sprite.region.z > sprite.region.x ? sprite.region : tileUVs.Get(*sprite.texture, sprite.size, sprite.atlasIndex);
+
+            // Array sprites share one state whatever their Texture, so they are keyed without one.
+            Queue(sprite.zLevel, sprite.blend, pipeline, layer >= 0 ? nullptr : sprite.texture, {&transform, &sprite, nullptr, pipeline, static_cast<uint32_t>(std::max(layer, 0)), uvRect});
+        });
+
+        // 2. Queue each visible emitter, padded by the largest particle size.
+        emitters.ForEach([this, currentCamera](Entity, ParticleEmitter& emitter)
+        {
+            if (!emitter.texture || !emitter.particles.Count()) { return; }
 
-            BatchEntry& batchEntry = batchMap[sprite.texture];
-            if (!batchEntry.beganThisFrame)
+            const glm::vec2 reach = emitter.size * (std::max(std::abs(emitter.startScale), std::abs(emitter.endScale)) * 0.5f);
+            const glm::vec2 min   = emitter.particles.BoundsMin() - reach;
+            const glm::vec2 max   = emitter.particles.BoundsMax() + reach;
+
+            if (max.x < currentCamera->viewMin.x || min.x > currentCamera->viewMax.x || max.y < currentCamera->viewMin.y || min.y > currentCamera->viewMax.y)
             {
-                batchEntry.batch.Begin(*sprite.texture, *currentCamera);
-                batchEntry.beganThisFrame = true;
+                culledCount += emitter.particles.Count();
+                return;
             }
 
-            SubmitSprite(batchEntry, transform, sprite);
+            Queue(emitter.zLevel, emitter.blend, Quads, emitter.texture, {nullptr, nullptr, &emitter, Quads, 0, {}});
         });
 
-        //2. Flush all batches.
-        for (auto& [texture, batchEntry] : batchMap)
+        // 3. Sort back to front and grouped by state, then write every item in that order across the workers.
+        queue.Sort();
+        WriteRuns(*currentCamera);
+
+        // 4. One draw per run. Nothing is appended from here on, so the buffers stay where the draws expect them.
+        BlendMode blend = BlendMode::Alpha;
+        for (const DrawRange& draw : draws)
         {
-            if (batchEntry.beganThisFrame)
+            if (draw.blend != blend) { ApplyBlendMode(blend = draw.blend); }
+
+            switch (draw.pipeline)
             {
-                batchEntry.batch.End();
-                batchEntry.batch.Reset();
-                batchEntry.beganThisFrame = false;
+                case Quads:          quads.Draw(*draw.texture, draw.first, draw.count);     break;
+                case Instances:      instances.Draw(*draw.texture, draw.first, draw.count); break;
+                case ArrayInstances: instances.Draw(*textureArray, draw.first, draw.count); break;
             }
         }
+
+        if (blend != BlendMode::Alpha) { ApplyBlendMode(BlendMode::Alpha); }
+
+        quads.End();
+        instances.End();
     }
 
-    void SpriteRenderer::SubmitSprite(BatchEntry& batchEntry, const Transform2D& transform, const Sprite& sprite)
+    void SpriteRenderer::ReportMemory(MemoryReport& report) const
     {
-        const glm::vec2 scaledSize = sprite.size * transform.scale;
+        quads.ReportMemory(report, "SpriteRenderer");
+        instances.ReportMemory(report, "SpriteRenderer");
 
-        // Atlas UV rectangle.
-        const int columns = sprite.texture->Width()  / static_cast<int>(sprite.size.x);
+        // The queue's table holds each Texture drawn last frame exactly once.
+        size_t textureBytes = 0;
+        for (const Texture* texture : queue.Textures())
+        {
+            if (texture) { textureBytes += texture->Bytes(); }
+        }
 
-        const int column = static_cast<int>(sprite.atlasIndex % columns);
-        const int row    = static_cast<int>(sprite.atlasIndex / columns);
+        report.Add("SpriteRenderer/textures", { textureBytes, textureBytes });
 
-        const float inverseWidth  = 1.0f / static_cast<float>(sprite.texture->Width());
-        const float inverseHeight = 1.0f / static_cast<float>(sprite.texture->Height());
+        if (textureArray) { report.Add("SpriteRenderer/texture array", { textureArray->Bytes(), textureArray->Bytes() }); }
 
-        const glm::vec2 uvMin { column * sprite.size.x * inverseWidth, 1.0f - (row + 1) * sprite.size.y * inverseHeight };
-        const glm::vec2 uvMax { uvMin.x  + sprite.size.x * inverseWidth, uvMin.y + sprite.size.y * inverseHeight };
+        report.Add("SpriteRenderer/render queue", queue.Memory());
+        report.Add("SpriteRenderer/queued items", VectorMemory(items));
+        report.Add("SpriteRenderer/item outputs", VectorMemory(outputs));
+        report.Add("SpriteRenderer/tile uv tables", tileUVs.Memory());
+        report.Add("SpriteRenderer/draw ranges", VectorMemory(draws));
 
-        // Local-Space Quad corners.
-        glm::vec2 localBL = { (0.0f - sprite.origin.x) * scaledSize.x, (0.0f - sprite.origin.y) * scaledSize.y };
-        glm::vec2 localBR = { (1.0f - sprite.origin.x) * scaledSize.x, (0.0f - sprite.origin.y) * scaledSize.y };
-        glm::vec2 localTR = { (1.0f - sprite.origin.x) * scaledSize.x, (1.0f - sprite.origin.y) * scaledSize.y };
-        glm::vec2 localTL = { (0.0f - sprite.origin.x) * scaledSize.x, (1.0f - sprite.origin.y) * scaledSize.y };
+        // Shared with every other quad renderer, so it is only counted here.
+        const std::shared_ptr<const QuadIndexBuffer> indices = QuadIndexBuffer::Acquire();
+        report.Add("SpriteRenderer/quad indices", { indices->Bytes(), indices->Bytes() });
+    }
 
-        // Apply rotation.
-        if (transform.rotation != 0.0f)
+    void SpriteRenderer::Queue(int32_t zLevel, BlendMode blend, Pipeline pipeline, const Texture* texture, const QueuedItem& item)
+    {
+        uint16_t slot = 0;
+        if (!queue.TextureSlot(texture, slot) || !queue.Push(zLevel, blend, pipeline, slot))
         {
-            localBL = RotateVec2(localBL, transform.rotation);
-            localBR = RotateVec2(localBR, transform.rotation);
-            localTR = RotateVec2(localTR, transform.rotation);
-            localTL = RotateVec2(localTL, transform.rotation);            
+            if (!queueFull) { TE_LOG_ERROR("SpriteRenderer: Render queue is full; dropping items this frame."); }
+            queueFull = true;
+            return;
         }
 
-        // Anchor translation.
-        const glm::vec2 anchorOffset = RotateVec2(glm::vec2((sprite.origin.x - sprite.anchor.x) * scaledSize.x, (sprite.origin.y - sprite.anchor.y) * scaledSize.y), transform.rotation);
+        items.push_back(item);
+    }
+
+    void SpriteRenderer::WriteRuns(const Camera2D& camera)
+    {
+        draws.clear();
+
+        const std::span<const uint64_t> keys = queue.Keys();
+        outputs.resize(keys.size());
+
+        // 1. Prefix sum over the sorted items: where each one's quads or instance go, and so the range each run draws.
+        size_t quadTotal     = 0;
+        size_t instanceTotal = 0;
+
+        for (const RenderQueue::Run& run : queue.Runs())
+        {
+            DrawRange& draw = draws.emplace_back();
+            draw.pipeline = static_cast<Pipeline>(run.pipeline);
+            draw.blend    = run.blend;
+            draw.texture  = queue.TextureAt(run.texture);
+
+            size_t& total = draw.pipeline == Quads ? quadTotal : instanceTotal;
+            draw.first = total;
+
+            for (uint32_t i = run.first; i < run.first + run.count; ++i)
+            {
+                const QueuedItem& item = items[RenderQueue::Item(keys[i])];
+
+                outputs[i] = total;
+                total += item.emitter ? item.emitter->particles.Count() : 1;
+            }
 
-        const glm::vec2 worldOrigin = transform.position + anchorOffset;
+            draw.count = total - draw.first;
+        }
 
-        const glm::vec2 bl = worldOrigin + localBL;
-        const glm::vec2 br = worldOrigin + localBR;
-        const glm::vec2 tr = worldOrigin + localTR;
-        const glm::vec2 tl = worldOrigin + localTL;
+        // 2. Reserve the whole frame at once. `Begin` waits for the GPU to release the region, so an unused batch is left alone.
+        Vertex*         quadOut     = nullptr;
+        SpriteInstance* instanceOut = nullptr;
 
-        const float depth = static_cast<float>(sprite.zLevel) * 0.01f;
+        if (quadTotal)
+        {
+            quads.Begin(camera);
+            quadOut = quads.AllocateQuads(quadTotal);
+        }
 
-        Vertex quad[4] = 
+        if (instanceTotal)
         {
-            { bl, {uvMin.x, uvMin.y}, sprite.tint, depth },
-            { br, {uvMax.x, uvMin.y}, sprite.tint, depth },
-            { tr, {uvMax.x, uvMax.y}, sprite.tint, depth },
-            { tl, {uvMin.x, uvMax.y}, sprite.tint, depth }
-        };
+            instances.Begin(camera);
+            instanceOut = instances.AllocateInstances(instanceTotal);
+        }
+
+        // A batch that could not map its buffer (already logged by `StreamBuffer`) drops its share of the frame rather than write through nothing.
+        std::erase_if(draws, [&](const DrawRange& draw) { return draw.pipeline == Quads ? !quadOut : !instanceOut; });
 
-        batchEntry.batch.SubmitQuad(quad);
+        // 3. Fill every item's slice. Slices never overlap, so workers write straight into the mapped buffers without synchronising.
+        workers.ParallelFor(keys.size(), ParallelChunk, [&](size_t begin, size_t end)
+        {
+            // CPU-expanded sprites with consecutive quads are gathered and expanded a group at a time.
+            QuadSource sources[QUAD_GROUP];
+            size_t     sourceCount = 0;
+            size_t     firstQuad   = 0;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const QueuedItem& item = items[RenderQueue::Item(keys[i])];
+
+                if (item.pipeline == Quads ? !quadOut : !instanceOut) { continue; }
+
+                if (item.pipeline == Quads && !item.emitter)
+                {
+                    if (sourceCount && (sourceCount == QUAD_GROUP || firstQuad + sourceCount != outputs[i]))
+                    {
+                        ExpandQuads(sources, sourceCount, quadOut + firstQuad * 4);
+                        sourceCount = 0;
+                    }
+
+                    if (!sourceCount) { firstQuad = outputs[i]; }
+                    sources[sourceCount++] = MakeQuadSource(*item.transform, *item.sprite, item.uvRect);
+                }
+                else if (item.emitter) { WriteParticles(quadOut + outputs[i] * 4, *item.emitter); }
+                else                   { WriteInstance(instanceOut[outputs[i]], item); }
+            }
+
+            if (sourceCount) { ExpandQuads(sources, sourceCount, quadOut + firstQuad * 4); }
+        });
     }
-}
\ No newline at end of file
+
+    void SpriteRenderer::WriteParticles(Vertex* quads, const ParticleEmitter& emitter) noexcept
+    {
+        ParticleLook look;
+        emitter.texture->TileUV(emitter.size, emitter.atlasIndex, look.uvMin, look.uvMax);
+
+        look.startSize   = emitter.size * emitter.startScale;
+        look.endSize     = emitter.size * emitter.endScale;
+        look.startColour = emitter.startColour;
+        look.endColour   = emitter.endColour;
+        look.depth       = static_cast<float>(emitter.zLevel) * 0.01f;
+
+        emitter.particles.WriteQuads(quads, look);
+    }
+
+    void SpriteRenderer::WriteInstance(SpriteInstance& instance, const QueuedItem& item) noexcept
+    {
+        const Transform2D& transform = *item.transform;
+        const Sprite&      sprite    = *item.sprite;
+
+        // Rotating about `origin` and then moving `origin` to the anchor is the same as rotating about the anchor, so `origin` is not needed here.
+        instance.position = transform.position;
+        instance.size     = sprite.size * transform.scale;
+        instance.anchor   = sprite.anchor;
+        instance.rotation = transform.rotation;
+        instance.depth    = static_cast<float>(sprite.zLevel) * 0.01f;
+        instance.uvRect   = { item.uvRect.x, item.uvRect.y, item.uvRect.z - item.uvRect.x, item.uvRect.w - item.uvRect.y };
+        instance.tint     = PackColour(sprite.tint);
+        instance.layer    = item.layer;
+    }
+}
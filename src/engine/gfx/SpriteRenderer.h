@@ -1,33 +1,122 @@
 #ifndef TERRANENGINE_SPRITERENDERER_H
 #define TERRANENGINE_SPRITERENDERER_H
 
+#include "engine/core/ThreadPool.h"
 #include "engine/ecs/System.h"
+#include "engine/gfx/QuadExpand.h"
+#include "engine/gfx/RenderQueue.h"
 #include "engine/gfx/SpriteBatch.h"
+#include "engine/gfx/SpriteInstanceBatch.h"
+#include "engine/gfx/TextureArray.h"
+#include "engine/gfx/TileUVTable.h"
 #include "engine/ecs/components/Components.h"
 #include "engine/ecs/world/World.h"
 
-#include <unordered_map>
+#include <vector>
 
 namespace TerranEngine
 {
+    /**
+     * @brief Draws every Entity with a `Transform2D` and a `Sprite`, and every `ParticleEmitter`, back to front in as few calls as possible.
+     *
+     * Every visible sprite and emitter is pushed to a `RenderQueue` keyed by z-level, blend mode, pipeline and texture. Once the queue is
+     * sorted, sprites are written into the frame's buffers in that order, and each run of equal state is drawn with one call. Blending is
+     * therefore correct between z-levels without relying on the depth test, and each texture is bound once per run rather than once per frame
+     * in pool order.
+     *
+     * In instanced mode (the default) each sprite is written as one `SpriteInstance` and expanded on the GPU; otherwise it is expanded into
+     * four `Vertex`es on the CPU. Particles are always written as quads, since `ParticleBuffer` already generates them in bulk. So are sprites
+     * whose tint has a channel outside [0, 1], since instances carry their tint as RGBA-8.
+     *
+     * Writing is spread over the engine's `ThreadPool`: a prefix sum over the sorted items gives each its slice of the frame's buffers, which the workers
+     * fill in parallel, leaving the main thread to issue draws.
+     *
+     * With a `TextureArray` set (instanced mode only), sprites whose Texture is one of its layers share the array's state, so those sprites
+     * take a single draw per run however many Textures they use.
+     */
     class SpriteRenderer final : public System
     {
     public:
-        SpriteRenderer() = default;
+        /** `workers` is shared with the rest of the engine and must outlive the renderer. */
+        explicit SpriteRenderer(ThreadPool& workers) : workers(workers) {}
 
+        void SetInstanced(bool enabled) noexcept { instanced = enabled; }
+        [[nodiscard]] bool IsInstanced() const noexcept { return instanced; }
+
+        /** Draw sprites of the Textures in `array` from the array, or stop doing so with `nullptr`. `array` must outlive its use here. */
+        void SetTextureArray(const TextureArray* array) noexcept { textureArray = array; }
+        [[nodiscard]] const TextureArray* GetTextureArray() const noexcept { return textureArray; }
+
+        void Bind(World& world);
         void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        /** Sprites and particles rejected by camera culling during the last Update. */
+        [[nodiscard]] size_t CulledCount() const noexcept { return culledCount; }
+
+        /** Draw calls issued by the last Update, one per run of the render queue. */
+        [[nodiscard]] size_t DrawCount() const noexcept { return draws.size(); }
 
     private:
-        struct BatchEntry
+        /** How a queued item is written and drawn. Part of its sort key. */
+        enum Pipeline : uint8_t
+        {
+            Quads,          // `SpriteBatch`: CPU-expanded sprites and particles.
+            Instances,      // `SpriteInstanceBatch` sampling the item's Texture.
+            ArrayInstances, // `SpriteInstanceBatch` sampling `textureArray`.
+        };
+
+        /** The component a queued item was made from. Exactly one of `sprite` and `emitter` is set. */
+        struct QueuedItem
+        {
+            const Transform2D*     transform {nullptr};
+            const Sprite*          sprite    {nullptr};
+            const ParticleEmitter* emitter   {nullptr};
+            Pipeline               pipeline  {Quads};
+            uint32_t               layer     {0}; // In `textureArray`, for `ArrayInstances`.
+            glm::vec4              uvRect    {0.0f, 0.0f, 0.0f, 0.0f}; // UV min and max of a sprite, resolved while queueing.
+        };
+
+        /** A run of the sorted queue, once written: which batch range to draw and how. */
+        struct DrawRange
         {
-            SpriteBatch batch;
-            bool beganThisFrame {false};
+            Pipeline       pipeline {Quads};
+            BlendMode      blend    {BlendMode::Alpha};
+            const Texture* texture  {nullptr};
+            size_t         first    {0};
+            size_t         count    {0};
         };
 
-        void SubmitSprite(BatchEntry& entry, const Transform2D& transform, const Sprite& sprite);
+        void Queue(int32_t zLevel, BlendMode blend, Pipeline pipeline, const Texture* texture, const QueuedItem& item);
+        void WriteRuns(const Camera2D& camera);
+
+        // Called from worker threads: they only read the item and write its own slice.
+        static void WriteInstance(SpriteInstance& instance, const QueuedItem& item) noexcept;
+        static void WriteParticles(Vertex* quads, const ParticleEmitter& emitter) noexcept;
 
     private:
-        std::unordered_map<const Texture*, BatchEntry> batchMap;
+        /** Sorted items per worker job. Small enough to balance emitters of very different sizes, large enough to keep jobs worthwhile. */
+        static constexpr size_t ParallelChunk = 2048;
+
+        RenderQueue             queue;
+        std::vector<QueuedItem> items;   // Indexed by queue item.
+        std::vector<size_t>     outputs; // First quad or instance of each sorted item.
+        std::vector<DrawRange>  draws;
+        TileUVTable             tileUVs;
+        ThreadPool&             workers;
+
+        SpriteBatch         quads;
+        SpriteInstanceBatch instances;
+
+        Query<Camera2D>            cameras;
+        Query<Transform2D, Sprite> sprites;
+        Query<ParticleEmitter>     emitters;
+
+        const TextureArray* textureArray {nullptr};
+
+        size_t culledCount {0};
+        bool   instanced   {true};
+        bool   queueFull   {false}; // Already reported this frame.
     };
 }
 
@@ -0,0 +1,101 @@
+#include "engine/gfx/StreamBuffer.h"
+
+#include "engine/core/Log.h"
+
+#include <cstring>
+
+namespace TerranEngine
+{
+    static constexpr GLbitfield STREAM_FLAGS  = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    static constexpr GLuint64   WAIT_TIMEOUT  = 1'000'000'000; // One second, in nanoseconds.
+    static constexpr size_t     MINIMUM_BYTES = 64 * 1024;
+
+    std::byte* StreamBuffer::Begin(size_t bytes)
+    {
+        if (bytes > regionBytes) { return Allocate(bytes, 0) ? mapped : nullptr; }
+
+        Wait(region);
+        return mapped + Offset();
+    }
+
+    std::byte* StreamBuffer::Grow(size_t bytes, size_t keepBytes)
+    {
+        if (bytes > regionBytes && !Allocate(bytes, keepBytes)) { return nullptr; }
+        return mapped + Offset();
+    }
+
+    void StreamBuffer::End()
+    {
+        if (!buffer) { return; }
+
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region = (region + 1) % RegionCount;
+    }
+
+    bool StreamBuffer::Allocate(size_t newRegionBytes, size_t keepBytes)
+    {
+        // Grow geometrically, so a frame that keeps growing re-creates the buffer a handful of times rather than on every quad.
+        size_t size = regionBytes ? regionBytes : MINIMUM_BYTES;
+        while (size < newRegionBytes) { size *= 2; }
+
+        GLuint newBuffer = 0;
+        glCreateBuffers(1, &newBuffer);
+        glNamedBufferStorage(newBuffer, static_cast<GLsizeiptr>(size * RegionCount), nullptr, STREAM_FLAGS);
+
+        auto* newMapped = static_cast<std::byte*>(glMapNamedBufferRange(newBuffer, 0, static_cast<GLsizeiptr>(size * RegionCount), STREAM_FLAGS));
+        if (!newMapped)
+        {
+            TE_LOG_ERROR("StreamBuffer: Failed to map {} bytes.", size * RegionCount);
+            glDeleteBuffers(1, &newBuffer);
+            return false;
+        }
+
+        // The new buffer starts at region 0. Carry over what this frame already wrote.
+        if (mapped && keepBytes) { std::memcpy(newMapped, mapped + Offset(), keepBytes); }
+
+        Release();
+
+        buffer      = newBuffer;
+        mapped      = newMapped;
+        regionBytes = size;
+        region      = 0;
+        return true;
+    }
+
+    void StreamBuffer::Wait(size_t index) noexcept
+    {
+        GLsync& fence = fences[index];
+        if (!fence) { return; }
+
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        while (status == GL_TIMEOUT_EXPIRED)
+        {
+            // Flush on the blocking wait, in case the fence itself has not reached the GPU yet.
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+        }
+
+        if (status == GL_WAIT_FAILED) { TE_LOG_ERROR("StreamBuffer: Waiting on a region fence failed."); }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void StreamBuffer::Release() noexcept
+    {
+        for (GLsync& fence : fences)
+        {
+            if (fence) { glDeleteSync(fence); fence = nullptr; }
+        }
+
+        if (buffer)
+        {
+            glUnmapNamedBuffer(buffer);
+            glDeleteBuffers(1, &buffer);
+        }
+
+        buffer      = 0;
+        mapped      = nullptr;
+        regionBytes = 0;
+        region      = 0;
+    }
+}
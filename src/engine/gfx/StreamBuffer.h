@@ -0,0 +1,65 @@
+#ifndef TERRANENGINE_STREAMBUFFER_H
+#define TERRANENGINE_STREAMBUFFER_H
+
+#include <glad/gl.h>
+
+#include <array>
+#include <cstddef>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Persistently mapped GPU buffer for data rewritten every frame, split into a ring of `RegionCount` equal regions.
+     *
+     * The buffer is created once with immutable storage and stays mapped (write, persistent, coherent), so the CPU writes straight into memory the
+     * GPU reads from, with no per-frame allocation or copy in the driver. Each frame writes one region: `Begin` waits until the GPU has finished
+     * with that region's previous contents, and `End` fences it after the draws that read it. With three regions the CPU can run two frames ahead
+     * before it ever waits.
+     *
+     * Regions only grow. When a frame needs more than a region holds, `Grow` re-creates the buffer at the new size and carries over what was
+     * already written. The old buffer is deleted straight away; GL keeps its storage alive until draws still using it have completed.
+     */
+    class StreamBuffer
+    {
+    public:
+        static constexpr size_t RegionCount = 3;
+
+        StreamBuffer() = default;
+        ~StreamBuffer() { Release(); }
+
+        StreamBuffer(const StreamBuffer&)            = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        /** Start writing the next region, at least `bytes` large. Waits for the GPU if it is still reading the region. Returns nullptr if a
+         *  larger buffer was needed and could not be mapped. */
+        [[nodiscard]] std::byte* Begin(size_t bytes);
+
+        /** Enlarge the current region to at least `bytes`, keeping the first `keepBytes` already written. Returns the new write pointer, or
+         *  nullptr if the larger buffer could not be mapped, in which case the current region is left as it was. */
+        [[nodiscard]] std::byte* Grow(size_t bytes, size_t keepBytes);
+
+        /** Fence the current region once the draws reading it are queued, and move on to the next one. */
+        void End();
+
+        /** Buffer and byte offset of the current region, for binding before drawing. */
+        [[nodiscard]] GLuint Buffer()      const noexcept { return buffer; }
+        [[nodiscard]] size_t Offset()      const noexcept { return region * regionBytes; }
+        [[nodiscard]] size_t RegionBytes() const noexcept { return regionBytes; }
+        [[nodiscard]] size_t Bytes()       const noexcept { return regionBytes * RegionCount; }
+
+    private:
+        bool Allocate(size_t newRegionBytes, size_t keepBytes);
+        void Wait(size_t index) noexcept;
+        void Release() noexcept;
+
+    private:
+        GLuint     buffer      {0};
+        std::byte* mapped      {nullptr};
+        size_t     regionBytes {0};
+        size_t     region      {0};
+
+        std::array<GLsync, RegionCount> fences {}; // Set once a region's draws are queued, cleared once they complete.
+    };
+}
+
+#endif // TERRANENGINE_STREAMBUFFER_H
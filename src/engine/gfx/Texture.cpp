@@ -23,17 +23,27 @@ namespace TerranEngine
             return;
         }
 
+        Upload(data);
+
+        stbi_image_free(data);
+        TE_LOG_INFO("Loaded texture '{}' ({} x {})", filePath, width, height);
+    }
+
+    Texture::Texture(int newWidth, int newHeight, const void* rgbaPixels) : width(newWidth), height(newHeight)
+    {
+        Upload(rgbaPixels);
+    }
+
+    void Texture::Upload(const void* rgbaPixels) noexcept
+    {
         glCreateTextures(GL_TEXTURE_2D, 1, &id);
         glTextureStorage2D(id, 1, GL_RGBA8, width, height);
-        glTextureSubImage2D(id, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glTextureSubImage2D(id, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
 
         glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, PixelFilter);
         glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, PixelFilter);
         glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        stbi_image_free(data);
-        TE_LOG_INFO("Loaded texture '{}' ({} x {})", filePath, width, height);
     }
 
     Texture::Texture(Texture&& otherTexture) noexcept : id(otherTexture.id), width(otherTexture.width), height(otherTexture.height)
@@ -2,6 +2,10 @@
 #define TERRANENGINE_TEXTURE_H
 
 #include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace TerranEngine
@@ -14,6 +18,9 @@ namespace TerranEngine
     public:
         Texture() = default;
         explicit Texture(std::string_view filePath, bool flipY = true);
+
+        /** Create a `newWidth x newHeight` texture from tightly packed RGBA-8 pixels, bottom row first. */
+        Texture(int newWidth, int newHeight, const void* rgbaPixels);
         ~Texture() { Release(); }
 
         Texture(Texture&& otherTexture) noexcept;
@@ -27,11 +34,30 @@ namespace TerranEngine
         [[nodiscard]] int Width()  const noexcept { return width; }
         [[nodiscard]] int Height() const noexcept { return height; }
 
+        /** UV rectangle of tile `atlasIndex` when the Texture is an atlas of `tileSize` pixel tiles, counted row-major from the top-left. */
+        void TileUV(const glm::vec2& tileSize, uint32_t atlasIndex, glm::vec2& uvMin, glm::vec2& uvMax) const noexcept
+        {
+            const int columns = width / static_cast<int>(tileSize.x);
+
+            const int column = static_cast<int>(atlasIndex % columns);
+            const int row    = static_cast<int>(atlasIndex / columns);
+
+            const float inverseWidth  = 1.0f / static_cast<float>(width);
+            const float inverseHeight = 1.0f / static_cast<float>(height);
+
+            uvMin = { column * tileSize.x * inverseWidth, 1.0f - (row + 1) * tileSize.y * inverseHeight };
+            uvMax = { uvMin.x + tileSize.x * inverseWidth, uvMin.y + tileSize.y * inverseHeight };
+        }
+
+        /** GPU storage held by the Texture (single RGBA-8 mip level). */
+        [[nodiscard]] size_t Bytes() const noexcept { return id ? static_cast<size_t>(width) * static_cast<size_t>(height) * 4 : 0; }
+
     private:
         GLuint id  {0};
         int width  {0};
         int height {0};
 
+        void Upload(const void* rgbaPixels) noexcept;
         void Release() noexcept;
     };
 }
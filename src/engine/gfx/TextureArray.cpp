@@ -0,0 +1,80 @@
+#include "engine/gfx/TextureArray.h"
+
+#include "engine/core/Log.h"
+
+namespace TerranEngine
+{
+    static constexpr GLint PixelFilter = GL_NEAREST;
+
+    bool TextureArray::Build(std::span<const Texture* const> textures)
+    {
+        Release();
+
+        if (textures.empty()) { return true; }
+
+        const int newWidth  = textures.front() ? textures.front()->Width()  : 0;
+        const int newHeight = textures.front() ? textures.front()->Height() : 0;
+
+        for (const Texture* texture : textures)
+        {
+            if (!texture || !texture->ID() || texture->Width() != newWidth || texture->Height() != newHeight)
+            {
+                TE_LOG_ERROR("TextureArray: Every layer must be a loaded {} x {} Texture.", newWidth, newHeight);
+                return false;
+            }
+        }
+
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+        if (textures.size() > static_cast<size_t>(maxLayers))
+        {
+            TE_LOG_ERROR("TextureArray: {} layers exceed the limit of {}.", textures.size(), maxLayers);
+            return false;
+        }
+
+        width      = newWidth;
+        height     = newHeight;
+        layerCount = static_cast<uint32_t>(textures.size());
+
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &id);
+        glTextureStorage3D(id, 1, GL_RGBA8, width, height, static_cast<GLsizei>(textures.size()));
+
+        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, PixelFilter);
+        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, PixelFilter);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        // Copied GPU to GPU, so nothing is decoded or read back.
+        for (size_t layer = 0; layer < textures.size(); ++layer)
+        {
+            // A Texture listed twice keeps its first layer; the second is simply never sampled.
+            layers.try_emplace(textures[layer], static_cast<uint32_t>(layer));
+
+            glCopyImageSubData(textures[layer]->ID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                               id, GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer),
+                               width, height, 1);
+        }
+
+        TE_LOG_INFO("TextureArray: Built {} layers of {} x {}.", textures.size(), width, height);
+        return true;
+    }
+
+    void TextureArray::Bind(unsigned int textureSlot) const noexcept
+    {
+        glBindTextureUnit(textureSlot, id);
+    }
+
+    void TextureArray::Release() noexcept
+    {
+        if (id)
+        {
+            glDeleteTextures(1, &id);
+            id = 0;
+        }
+
+        layers.clear();
+        width      = 0;
+        height     = 0;
+        layerCount = 0;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef TERRANENGINE_TEXTUREARRAY_H
+#define TERRANENGINE_TEXTUREARRAY_H
+
+#include "engine/gfx/Texture.h"
+
+#include <glad/gl.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+
+namespace TerranEngine
+{
+    /**
+     * @brief `GL_TEXTURE_2D_ARRAY` holding same-sized `Texture`s as layers, so sprites of every one of them can share a single draw.
+     *
+     * Layers are copied on the GPU from existing Textures, which keep working on their own. A sprite keeps referencing its original Texture;
+     * renderers look its layer up with `Layer` and sample the array with that layer instead. UVs carry over unchanged since every layer has the
+     * size of its source.
+     */
+    class TextureArray
+    {
+    public:
+        TextureArray() = default;
+        ~TextureArray() { Release(); }
+
+        TextureArray(const TextureArray&)            = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+
+        /** Copy `textures` into layers 0 to N-1, replacing any previous contents. Every Texture must be loaded and of the same size. */
+        bool Build(std::span<const Texture* const> textures);
+
+        /** Layer holding `texture`, or -1 if it is not in the array. */
+        [[nodiscard]] int Layer(const Texture* texture) const noexcept
+        {
+            const auto it = layers.find(texture);
+            return it != layers.end() ? static_cast<int>(it->second) : -1;
+        }
+
+        void Bind(unsigned int textureSlot = 0) const noexcept;
+
+        [[nodiscard]] GLuint   ID()         const noexcept { return id; }
+        [[nodiscard]] int      Width()      const noexcept { return width; }
+        [[nodiscard]] int      Height()     const noexcept { return height; }
+        [[nodiscard]] uint32_t LayerCount() const noexcept { return layerCount; }
+
+        /** GPU storage held by the array (single RGBA-8 mip level per layer). */
+        [[nodiscard]] size_t Bytes() const noexcept { return id ? static_cast<size_t>(width) * static_cast<size_t>(height) * 4 * layerCount : 0; }
+
+    private:
+        void Release() noexcept;
+
+    private:
+        std::unordered_map<const Texture*, uint32_t> layers;
+
+        GLuint   id         {0};
+        int      width      {0};
+        int      height     {0};
+        uint32_t layerCount {0};
+    };
+}
+
+#endif // TERRANENGINE_TEXTUREARRAY_H
@@ -0,0 +1,303 @@
+#include "engine/gfx/TextureAtlas.h"
+
+#include "engine/core/Log.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <string>
+
+namespace TerranEngine
+{
+    static constexpr size_t BYTES_PER_PIXEL = 4;
+
+    /** Skyline bottom-left packer for one page. Nodes are the horizontal segments of the packed area's top edge, left to right. */
+    class Skyline
+    {
+    public:
+        explicit Skyline(int pageSize) : size(pageSize) { nodes.push_back({0, 0, pageSize}); }
+
+        /** Place a `width x height` rectangle, returning false if it fits nowhere. */
+        bool Insert(int width, int height, glm::ivec2& position)
+        {
+            size_t bestIndex  = nodes.size();
+            int    bestTop    = size + 1;
+            int    bestWidth  = 0;
+
+            for (size_t i = 0; i < nodes.size(); ++i)
+            {
+                int y = 0;
+                if (!Fit(i, width, height, y)) { continue; }
+
+                if (y + height < bestTop || (y + height == bestTop && nodes[i].z < bestWidth))
+                {
+                    bestIndex = i;
+                    bestTop   = y + height;
+                    bestWidth = nodes[i].z;
+                    position  = {nodes[i].x, y};
+                }
+            }
+
+            if (bestIndex == nodes.size()) { return false; }
+
+            // The new segment covers the rectangle's top; segments it overhangs are trimmed or dropped.
+            nodes.insert(nodes.begin() + static_cast<std::ptrdiff_t>(bestIndex), glm::ivec3 {position.x, position.y + height, width});
+
+            for (size_t i = bestIndex + 1; i < nodes.size();)
+            {
+                const int overlap = nodes[i - 1].x + nodes[i - 1].z - nodes[i].x;
+                if (overlap <= 0) { break; }
+
+                nodes[i].x += overlap;
+                nodes[i].z -= overlap;
+
+                if (nodes[i].z > 0) { break; }
+                nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+
+            // Merge neighbours at the same height.
+            for (size_t i = 0; i + 1 < nodes.size();)
+            {
+                if (nodes[i].y == nodes[i + 1].y)
+                {
+                    nodes[i].z += nodes[i + 1].z;
+                    nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                }
+                else { ++i; }
+            }
+
+            usedHeight = std::max(usedHeight, position.y + height);
+            return true;
+        }
+
+        [[nodiscard]] int UsedHeight() const noexcept { return usedHeight; }
+
+    private:
+        /** Lowest y at which a rectangle starting at node `index` rests on the skyline. */
+        bool Fit(size_t index, int width, int height, int& y) const noexcept
+        {
+            if (nodes[index].x + width > size) { return false; }
+
+            y = nodes[index].y;
+            for (size_t i = index, remaining = static_cast<size_t>(width); remaining > 0 && i < nodes.size(); ++i)
+            {
+                y = std::max(y, nodes[i].y);
+                if (y + height > size) { return false; }
+
+                remaining -= std::min(remaining, static_cast<size_t>(nodes[i].z));
+            }
+
+            return true;
+        }
+
+    private:
+        std::vector<glm::ivec3> nodes; // x, y, width.
+        int                     size       {0};
+        int                     usedHeight {0};
+    };
+
+    TextureAtlas::RegionID TextureAtlas::Add(std::string_view filePath)
+    {
+        const std::shared_ptr<const Image> image = Load(filePath);
+        if (!image) { return InvalidRegion; }
+
+        return Queue(image, {0, 0}, {image->width, image->height});
+    }
+
+    TextureAtlas::RegionID TextureAtlas::AddGrid(std::string_view filePath, glm::ivec2 cellSize, uint32_t& cellCount)
+    {
+        cellCount = 0;
+
+        const std::shared_ptr<const Image> image = Load(filePath);
+        if (!image || cellSize.x <= 0 || cellSize.y <= 0) { return InvalidRegion; }
+
+        const int columns = image->width / cellSize.x;
+        const int rows    = image->height / cellSize.y;
+        const auto first  = static_cast<RegionID>(regions.size());
+
+        // Rows are counted from the top, but pixels are stored bottom row first.
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int column = 0; column < columns; ++column)
+            {
+                Queue(image, {column * cellSize.x, image->height - (row + 1) * cellSize.y}, cellSize);
+            }
+        }
+
+        cellCount = static_cast<uint32_t>(columns * rows);
+        return cellCount ? first : InvalidRegion;
+    }
+
+    TextureAtlas::RegionID TextureAtlas::Add(int width, int height, const void* rgbaPixels)
+    {
+        if (width <= 0 || height <= 0 || !rgbaPixels) { return InvalidRegion; }
+
+        auto image = std::make_shared<Image>();
+        image->width  = width;
+        image->height = height;
+        image->pixels.assign(static_cast<const uint8_t*>(rgbaPixels), static_cast<const uint8_t*>(rgbaPixels) + static_cast<size_t>(width) * height * BYTES_PER_PIXEL);
+
+        return Queue(std::move(image), {0, 0}, {width, height});
+    }
+
+    TextureAtlas::RegionID TextureAtlas::Queue(std::shared_ptr<const Image> image, glm::ivec2 offset, glm::ivec2 size)
+    {
+        const auto id = static_cast<RegionID>(regions.size());
+
+        sources.push_back({std::move(image), id, offset, size});
+        regions.emplace_back();
+        return id;
+    }
+
+    bool TextureAtlas::Build(int pageSize, int padding)
+    {
+        padding = std::max(padding, 0);
+
+        // 1. Place regions tallest first, trying every open page before opening a new one.
+        std::vector<size_t> order(sources.size());
+        std::iota(order.begin(), order.end(), size_t {0});
+        std::ranges::stable_sort(order, [&](size_t a, size_t b)
+        {
+            return sources[a].size.y != sources[b].size.y ? sources[a].size.y > sources[b].size.y : sources[a].size.x > sources[b].size.x;
+        });
+
+        struct Placement
+        {
+            size_t     page     {0};
+            glm::ivec2 position {0, 0}; // Of the region itself, inside its padding.
+            bool       placed   {false};
+        };
+
+        std::vector<Skyline>   skylines;
+        std::vector<Placement> placements(sources.size());
+        bool                   complete = true;
+
+        for (const size_t index : order)
+        {
+            const Source&    source = sources[index];
+            const glm::ivec2 padded = source.size + 2 * padding;
+            if (padded.x > pageSize || padded.y > pageSize)
+            {
+                TE_LOG_ERROR("TextureAtlas: Region {} ({} x {}) does not fit a {} pixel page.", source.id, source.size.x, source.size.y, pageSize);
+                complete = false;
+                continue;
+            }
+
+            Placement& placement = placements[index];
+            glm::ivec2 position;
+
+            for (size_t page = 0; page < skylines.size() && !placement.placed; ++page)
+            {
+                if (skylines[page].Insert(padded.x, padded.y, position)) { placement = {page, position + padding, true}; }
+            }
+
+            if (!placement.placed)
+            {
+                skylines.emplace_back(pageSize);
+                skylines.back().Insert(padded.x, padded.y, position);
+                placement = {skylines.size() - 1, position + padding, true};
+            }
+        }
+
+        // 2. Copy every region into its page with extruded edges. Pages are trimmed to the power-of-two height they use.
+        std::vector<glm::ivec2>           pageSizes(skylines.size());
+        std::vector<std::vector<uint8_t>> pagePixels(skylines.size());
+
+        for (size_t page = 0; page < skylines.size(); ++page)
+        {
+            pageSizes[page] = {pageSize, std::min(pageSize, static_cast<int>(std::bit_ceil(static_cast<uint32_t>(skylines[page].UsedHeight()))))};
+            pagePixels[page].assign(static_cast<size_t>(pageSizes[page].x) * pageSizes[page].y * BYTES_PER_PIXEL, 0);
+        }
+
+        for (size_t index = 0; index < sources.size(); ++index)
+        {
+            const Placement& placement = placements[index];
+            if (!placement.placed) { continue; }
+
+            const Source&    source = sources[index];
+            const glm::ivec2 page   = pageSizes[placement.page];
+            uint8_t*         out    = pagePixels[placement.page].data();
+
+            for (int y = -padding; y < source.size.y + padding; ++y)
+            {
+                const int      sourceY   = source.offset.y + std::clamp(y, 0, source.size.y - 1);
+                const uint8_t* sourceRow = source.image->pixels.data() + (static_cast<size_t>(sourceY) * source.image->width + source.offset.x) * BYTES_PER_PIXEL;
+                uint8_t*       outRow    = out + (static_cast<size_t>(placement.position.y + y) * page.x + placement.position.x) * BYTES_PER_PIXEL;
+
+                std::memcpy(outRow, sourceRow, static_cast<size_t>(source.size.x) * BYTES_PER_PIXEL);
+
+                for (int x = 1; x <= padding; ++x)
+                {
+                    std::memcpy(outRow - x * static_cast<std::ptrdiff_t>(BYTES_PER_PIXEL), sourceRow, BYTES_PER_PIXEL);
+                    std::memcpy(outRow + (static_cast<size_t>(source.size.x - 1) + x) * BYTES_PER_PIXEL, sourceRow + static_cast<size_t>(source.size.x - 1) * BYTES_PER_PIXEL, BYTES_PER_PIXEL);
+                }
+            }
+        }
+
+        // 3. Upload the pages and resolve every region's UVs.
+        const size_t firstPage = pages.size();
+        for (size_t page = 0; page < pagePixels.size(); ++page)
+        {
+            pages.push_back(std::make_unique<Texture>(pageSizes[page].x, pageSizes[page].y, pagePixels[page].data()));
+        }
+
+        for (size_t index = 0; index < sources.size(); ++index)
+        {
+            const Placement& placement = placements[index];
+            if (!placement.placed) { continue; }
+
+            const glm::vec2 page   = pageSizes[placement.page];
+            const Source&   source = sources[index];
+
+            AtlasRegion& region = regions[source.id];
+            region.texture = pages[firstPage + placement.page].get();
+            region.size    = source.size;
+            region.uvMin   = glm::vec2(placement.position) / page;
+            region.uvMax   = glm::vec2(placement.position + source.size) / page;
+        }
+
+        TE_LOG_INFO("TextureAtlas: Packed {} regions into {} pages.", sources.size(), skylines.size());
+
+        std::vector<Source> {}.swap(sources);
+        return complete;
+    }
+
+    const AtlasRegion& TextureAtlas::Region(RegionID id) const noexcept
+    {
+        static const AtlasRegion invalid;
+        return id < regions.size() ? regions[id] : invalid;
+    }
+
+    MemoryUsage TextureAtlas::Memory() const noexcept
+    {
+        size_t bytes = 0;
+        for (const std::unique_ptr<Texture>& page : pages) { bytes += page->Bytes(); }
+
+        return { bytes, bytes };
+    }
+
+    std::shared_ptr<const TextureAtlas::Image> TextureAtlas::Load(std::string_view filePath)
+    {
+        // Bottom row first, like `Texture`, so UVs come out the same way up.
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        const std::string path {filePath};
+
+        auto image = std::make_shared<Image>();
+        int channels = 0;
+        unsigned char* data = stbi_load(path.c_str(), &image->width, &image->height, &channels, STBI_rgb_alpha);
+
+        if (!data)
+        {
+            TE_LOG_ERROR("TextureAtlas: Failed to load '{}'.", filePath);
+            return nullptr;
+        }
+
+        image->pixels.assign(data, data + static_cast<size_t>(image->width) * image->height * BYTES_PER_PIXEL);
+        stbi_image_free(data);
+        return image;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef TERRANENGINE_TEXTUREATLAS_H
+#define TERRANENGINE_TEXTUREATLAS_H
+
+#include "engine/gfx/Texture.h"
+#include "engine/ecs/components/Sprite.h"
+#include "engine/core/MemoryReport.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace TerranEngine
+{
+    /** A packed image: the page it landed on and its UV rectangle there. */
+    struct AtlasRegion
+    {
+        const Texture* texture {nullptr};
+        glm::vec2      uvMin   {0.0f, 0.0f};
+        glm::vec2      uvMax   {0.0f, 0.0f};
+        glm::ivec2     size    {0, 0}; // Pixels.
+
+        [[nodiscard]] bool IsValid() const noexcept { return texture != nullptr; }
+
+        /** Point `sprite` at this region, sized to its pixels. */
+        void AssignTo(Sprite& sprite) const noexcept
+        {
+            sprite.texture = texture;
+            sprite.size    = glm::vec2(size);
+            sprite.region  = { uvMin.x, uvMin.y, uvMax.x, uvMax.y };
+        }
+    };
+
+    /**
+     * @brief Packs many images and sprite sheet cells into a few large texture pages at load time.
+     *
+     * Images are queued with `Add`/`AddGrid`, which return region handles, then `Build` packs them all and uploads the pages. Sprites that
+     * reference regions (`AtlasRegion::AssignTo`) rather than their original textures share the page's batch, so dozens of small sheets draw
+     * in a few calls.
+     *
+     * ### Packing.
+     *
+     * Regions are placed tallest first with a skyline bottom-left packer: the top edge of the packed area is kept as a list of horizontal
+     * segments, and each region goes where its top edge would be lowest, breaking ties towards the narrowest fit. A new page is opened when a
+     * region fits nowhere on the current one.
+     *
+     * Each region is surrounded by `padding` pixels copied from its own edges, so nearest sampling right at a region's border never picks up
+     * its neighbour.
+     */
+    class TextureAtlas
+    {
+    public:
+        using RegionID = uint32_t;
+
+        static constexpr RegionID InvalidRegion = 0xFFFFFFFFu;
+
+        TextureAtlas() = default;
+
+        TextureAtlas(const TextureAtlas&)            = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        /** Queue a whole image file. Returns `InvalidRegion` if it cannot be loaded. */
+        RegionID Add(std::string_view filePath);
+
+        /** Queue every `cellSize` cell of a sprite sheet, row-major from the top-left (matching `Texture::TileUV`). Returns the first cell's handle; the rest follow consecutively. */
+        RegionID AddGrid(std::string_view filePath, glm::ivec2 cellSize, uint32_t& cellCount);
+
+        /** Queue tightly packed RGBA-8 pixels, bottom row first. */
+        RegionID Add(int width, int height, const void* rgbaPixels);
+
+        /** Pack every queued image into `pageSize` square pages and upload them. Queued pixels are released afterwards. */
+        bool Build(int pageSize = 2048, int padding = 1);
+
+        /** Region of a handle. Invalid until `Build` succeeds. */
+        [[nodiscard]] const AtlasRegion& Region(RegionID id) const noexcept;
+
+        [[nodiscard]] size_t RegionCount() const noexcept { return regions.size(); }
+        [[nodiscard]] size_t PageCount()   const noexcept { return pages.size(); }
+
+        [[nodiscard]] MemoryUsage Memory() const noexcept;
+
+    private:
+        struct Image
+        {
+            int                  width  {0};
+            int                  height {0};
+            std::vector<uint8_t> pixels; // RGBA-8, bottom row first.
+        };
+
+        /** Queued part of an image. */
+        struct Source
+        {
+            std::shared_ptr<const Image> image;
+            RegionID                     id     {InvalidRegion};
+            glm::ivec2                   offset {0, 0};
+            glm::ivec2                   size   {0, 0};
+        };
+
+        RegionID Queue(std::shared_ptr<const Image> image, glm::ivec2 offset, glm::ivec2 size);
+
+        [[nodiscard]] static std::shared_ptr<const Image> Load(std::string_view filePath);
+
+    private:
+        std::vector<Source>                   sources; // Waiting for the next `Build`.
+        std::vector<AtlasRegion>              regions; // Indexed by RegionID.
+        std::vector<std::unique_ptr<Texture>> pages;   // Heap allocated, so region pointers survive adding pages.
+    };
+}
+
+#endif // TERRANENGINE_TEXTUREATLAS_H
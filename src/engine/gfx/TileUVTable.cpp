@@ -0,0 +1,73 @@
+#include "engine/gfx/TileUVTable.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace TerranEngine
+{
+    size_t TileUVTable::KeyHash::operator()(const Key& key) const noexcept
+    {
+        size_t hash = std::hash<int> {}(key.width);
+        hash = hash * 31 + std::hash<int> {}(key.height);
+        hash = hash * 31 + std::hash<float> {}(key.tileWidth);
+        hash = hash * 31 + std::hash<float> {}(key.tileHeight);
+        return hash;
+    }
+
+    glm::vec4 TileUVTable::Get(const Texture& texture, const glm::vec2& tileSize, uint32_t atlasIndex)
+    {
+        const Key key {texture.Width(), texture.Height(), tileSize.x, tileSize.y};
+
+        if (!lastTable || !(key == lastKey))
+        {
+            // Tiles under a pixel wide would divide by zero in `TileUV`; there is nothing sensible to sample.
+            if (static_cast<int>(tileSize.x) <= 0 || static_cast<int>(tileSize.y) <= 0) { return {0.0f, 0.0f, 0.0f, 0.0f}; }
+
+            const auto it = tables.find(key);
+            lastTable = it != tables.end() ? &it->second : &Build(texture, tileSize, key);
+            lastKey   = key;
+        }
+
+        if (atlasIndex < lastTable->size()) { return (*lastTable)[atlasIndex]; }
+
+        glm::vec2 uvMin;
+        glm::vec2 uvMax;
+        texture.TileUV(tileSize, atlasIndex, uvMin, uvMax);
+        return {uvMin.x, uvMin.y, uvMax.x, uvMax.y};
+    }
+
+    const std::vector<glm::vec4>& TileUVTable::Build(const Texture& texture, const glm::vec2& tileSize, const Key& key)
+    {
+        const auto columns = static_cast<uint32_t>(std::max(texture.Width() / static_cast<int>(tileSize.x), 0));
+        const auto rows    = static_cast<uint32_t>(std::max(texture.Height() / static_cast<int>(tileSize.y), 0));
+
+        // Oversized grids get an empty table, so every lookup falls through to `TileUV`.
+        std::vector<glm::vec4>& table = tables[key];
+        if (!columns || static_cast<uint64_t>(columns) * rows > MaxTiles) { return table; }
+
+        table.resize(static_cast<size_t>(columns) * rows);
+        for (uint32_t index = 0; index < table.size(); ++index)
+        {
+            glm::vec2 uvMin;
+            glm::vec2 uvMax;
+            texture.TileUV(tileSize, index, uvMin, uvMax);
+            table[index] = {uvMin.x, uvMin.y, uvMax.x, uvMax.y};
+        }
+
+        return table;
+    }
+
+    void TileUVTable::Clear() noexcept
+    {
+        tables.clear();
+        lastTable = nullptr;
+    }
+
+    MemoryUsage TileUVTable::Memory() const noexcept
+    {
+        MemoryUsage usage;
+        for (const auto& [key, table] : tables) { usage += VectorMemory(table); }
+
+        return usage;
+    }
+}
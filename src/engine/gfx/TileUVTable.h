@@ -0,0 +1,65 @@
+#ifndef TERRANENGINE_TILEUVTABLE_H
+#define TERRANENGINE_TILEUVTABLE_H
+
+#include "engine/gfx/Texture.h"
+#include "engine/core/MemoryReport.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief UV rectangles of every tile of each texture and tile size in use, so a sprite's UVs are an index rather than `Texture::TileUV`'s
+     * division, modulo and reciprocals.
+     *
+     * Tables are keyed by texture size and tile size, which alone decide the UVs. Textures of the same size share a table, and a Texture
+     * replaced at the same address can never read a stale one. Grids of more than `MaxTiles` tiles, and indices past the grid, are computed
+     * directly instead.
+     */
+    class TileUVTable
+    {
+    public:
+        static constexpr uint32_t MaxTiles = 1u << 16;
+
+        /** UV min (xy) and max (zw) of tile `atlasIndex`, exactly as `Texture::TileUV` computes them. */
+        [[nodiscard]] glm::vec4 Get(const Texture& texture, const glm::vec2& tileSize, uint32_t atlasIndex);
+
+        void Clear() noexcept;
+
+        [[nodiscard]] MemoryUsage Memory() const noexcept;
+
+    private:
+        struct Key
+        {
+            int   width      {0};
+            int   height     {0};
+            float tileWidth  {0.0f};
+            float tileHeight {0.0f};
+
+            [[nodiscard]] bool operator==(const Key& other) const noexcept
+            {
+                return width == other.width && height == other.height && tileWidth == other.tileWidth && tileHeight == other.tileHeight;
+            }
+        };
+
+        struct KeyHash
+        {
+            [[nodiscard]] size_t operator()(const Key& key) const noexcept;
+        };
+
+        [[nodiscard]] const std::vector<glm::vec4>& Build(const Texture& texture, const glm::vec2& tileSize, const Key& key);
+
+    private:
+        std::unordered_map<Key, std::vector<glm::vec4>, KeyHash> tables;
+
+        Key                           lastKey;              // Most sprites repeat the previous sprite's texture and tile size.
+        const std::vector<glm::vec4>* lastTable {nullptr};
+    };
+}
+
+#endif // TERRANENGINE_TILEUVTABLE_H
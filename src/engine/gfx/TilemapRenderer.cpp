@@ -0,0 +1,270 @@
+#include "engine/gfx/TilemapRenderer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace TerranEngine
+{
+    static constexpr int QUADS_PER_CHUNK = Tilemap::ChunkSize * Tilemap::ChunkSize;
+
+    static_assert(QUADS_PER_CHUNK <= QuadIndexBuffer::MaxQuads, "A chunk must be drawable in a single QuadIndexBuffer slice.");
+    static_assert(Tilemap::ChunkSize <= 32, "Greedy meshing keeps one 32-bit coverage mask per chunk row.");
+
+    TilemapRenderer::TilemapRenderer()
+    {
+        glCreateVertexArrays(1, &vao);
+        glVertexArrayElementBuffer(vao, indices->ID());
+
+        glEnableVertexArrayAttrib(vao, 0);
+        glVertexArrayAttribFormat(vao, 0, 2, GL_FLOAT, GL_FALSE, offsetof(TileVertex, position));
+        glVertexArrayAttribBinding(vao, 0, 0);
+
+        glEnableVertexArrayAttrib(vao, 1);
+        glVertexArrayAttribFormat(vao, 1, 2, GL_FLOAT, GL_FALSE, offsetof(TileVertex, repeat));
+        glVertexArrayAttribBinding(vao, 1, 0);
+
+        glEnableVertexArrayAttrib(vao, 2);
+        glVertexArrayAttribFormat(vao, 2, 4, GL_FLOAT, GL_FALSE, offsetof(TileVertex, tileRect));
+        glVertexArrayAttribBinding(vao, 2, 0);
+
+        glEnableVertexArrayAttrib(vao, 3);
+        glVertexArrayAttribFormat(vao, 3, 1, GL_FLOAT, GL_FALSE, offsetof(TileVertex, depth));
+        glVertexArrayAttribBinding(vao, 3, 0);
+    }
+
+    TilemapRenderer::~TilemapRenderer()
+    {
+        for (auto& [entity, mesh] : meshes) { Release(mesh); }
+
+        glDeleteVertexArrays(1, &vao);
+    }
+
+    void TilemapRenderer::Bind(World& world)
+    {
+        world.BindQuery(cameras);
+        world.BindQuery(tilemaps);
+    }
+
+    void TilemapRenderer::Update(World& world, float)
+    {
+        Bind(world);
+
+        Camera2D* currentCamera = nullptr;
+        cameras.ForEach([&](Entity, Camera2D& camera)
+        {
+            if (!currentCamera || camera.primary) { currentCamera = &camera; }
+        });
+
+        if (!currentCamera) { return; }
+
+        ++stamp;
+        drawnChunks   = 0;
+        drawnQuads    = 0;
+        rebuiltChunks = 0;
+
+        shader->Use();
+        shader->SetUniform("uTexture0", 0);
+        shader->SetUniform("uTransform", currentCamera->viewProjection);
+        glBindVertexArray(vao);
+
+        tilemaps.ForEach([&](Entity entity, Transform2D& transform, Tilemap& tilemap)
+        {
+            if (!tilemap.atlas || !world.IsAlive(entity)) { return; }
+
+            MapMesh& mesh = meshes[entity.Raw()];
+            mesh.stamp = stamp;
+            Prepare(mesh, transform, tilemap);
+
+            // Chunks overlapping the camera bounds.
+            const glm::vec2  chunkPx = tilemap.tileSize * static_cast<float>(Tilemap::ChunkSize);
+            const glm::ivec2 first   = glm::max(glm::ivec2(glm::floor((currentCamera->viewMin - mesh.origin) / chunkPx)), glm::ivec2 {0, 0});
+            const glm::ivec2 last    = glm::min(glm::ivec2(glm::floor((currentCamera->viewMax - mesh.origin) / chunkPx)), mesh.chunkCount - 1);
+
+            if (first.x > last.x || first.y > last.y) { return; }
+
+            tilemap.atlas->Bind(0);
+
+            for (int y = first.y; y <= last.y; ++y)
+            {
+                for (int x = first.x; x <= last.x; ++x)
+                {
+                    ChunkMesh& chunkMesh = mesh.chunks[static_cast<size_t>(y) * mesh.chunkCount.x + x];
+
+                    if (chunkMesh.revision != tilemap.ChunkRevision({x, y}))
+                    {
+                        BuildChunk(tilemap, mesh, {x, y}, chunkMesh);
+                        ++rebuiltChunks;
+                    }
+
+                    if (!chunkMesh.quadCount) { continue; }
+
+                    glVertexArrayVertexBuffer(vao, 0, chunkMesh.vbo, 0, sizeof(TileVertex));
+                    QuadIndexBuffer::Draw(chunkMesh.quadCount);
+                    ++drawnChunks;
+                    drawnQuads += chunkMesh.quadCount;
+                }
+            }
+        });
+
+        // Drop the buffers of Tilemaps that were destroyed or removed.
+        for (auto entry = meshes.begin(); entry != meshes.end();)
+        {
+            if (entry->second.stamp == stamp) { ++entry; continue; }
+
+            Release(entry->second);
+            entry = meshes.erase(entry);
+        }
+    }
+
+    void TilemapRenderer::Prepare(MapMesh& mesh, const Transform2D& transform, const Tilemap& tilemap)
+    {
+        const glm::ivec2 chunkCount {tilemap.ChunksX(), tilemap.ChunksY()};
+
+        const bool unchanged = mesh.chunkCount == chunkCount && mesh.origin == transform.position && mesh.tileSize == tilemap.tileSize
+                            && mesh.atlas == tilemap.atlas && mesh.zLevel == tilemap.zLevel && mesh.merge == tilemap.merge;
+        if (unchanged) { return; }
+
+        // Vertices bake in all of these, so every chunk has to be rebuilt. Buffers are kept for reuse where possible.
+        if (mesh.chunkCount != chunkCount)
+        {
+            Release(mesh);
+            mesh.chunks.resize(static_cast<size_t>(chunkCount.x) * chunkCount.y);
+        }
+
+        for (ChunkMesh& chunkMesh : mesh.chunks) { chunkMesh.revision = 0; }
+
+        mesh.chunkCount = chunkCount;
+        mesh.origin     = transform.position;
+        mesh.tileSize   = tilemap.tileSize;
+        mesh.atlas      = tilemap.atlas;
+        mesh.zLevel     = tilemap.zLevel;
+        mesh.merge      = tilemap.merge;
+    }
+
+    void TilemapRenderer::BuildChunk(const Tilemap& tilemap, const MapMesh& mesh, glm::ivec2 chunk, ChunkMesh& chunkMesh)
+    {
+        const glm::ivec2 first = chunk * Tilemap::ChunkSize;
+        const glm::ivec2 size  = glm::min(first + Tilemap::ChunkSize, glm::ivec2 {tilemap.Width(), tilemap.Height()}) - first;
+
+        vertices.clear();
+
+        // A uniform chunk needs no decoding: it is one quad when merging, and nothing at all when empty.
+        uint16_t uniformID = 0;
+        const bool uniform = tilemap.Tiles().IsUniform(chunk, uniformID);
+
+        if (uniform && (uniformID == Tilemap::Empty || tilemap.merge))
+        {
+            if (uniformID != Tilemap::Empty) { AddQuad(tilemap, mesh, first, size, uniformID); }
+        }
+        else
+        {
+            std::array<uint16_t, QUADS_PER_CHUNK> ids;
+            tilemap.Tiles().ReadChunk(chunk, ids, Tilemap::Empty);
+
+            auto idAt = [&](int x, int y) noexcept { return ids[static_cast<size_t>(y) * Tilemap::ChunkSize + x]; };
+
+            if (!tilemap.merge)
+            {
+                for (int y = 0; y < size.y; ++y)
+                {
+                    for (int x = 0; x < size.x; ++x)
+                    {
+                        if (idAt(x, y) != Tilemap::Empty) { AddQuad(tilemap, mesh, first + glm::ivec2 {x, y}, {1, 1}, idAt(x, y)); }
+                    }
+                }
+            }
+            else
+            {
+                // Greedy meshing. Each row keeps a bit per tile already covered by a quad; the first uncovered tile grows right while the ID matches,
+                // then the whole run grows up while every tile of the next row matches and is uncovered.
+                std::array<uint32_t, Tilemap::ChunkSize> covered {};
+
+                for (int y = 0; y < size.y; ++y)
+                {
+                    for (int x = 0; x < size.x; ++x)
+                    {
+                        const uint16_t id = idAt(x, y);
+                        if (id == Tilemap::Empty || (covered[y] >> x) & 1u) { continue; }
+
+                        int width = 1;
+                        while (x + width < size.x && idAt(x + width, y) == id && !((covered[y] >> (x + width)) & 1u)) { ++width; }
+
+                        const uint32_t run = (width == 32 ? ~0u : (1u << width) - 1u) << x;
+
+                        int height = 1;
+                        while (y + height < size.y && !(covered[y + height] & run))
+                        {
+                            bool matches = true;
+                            for (int column = x; column < x + width && matches; ++column) { matches = idAt(column, y + height) == id; }
+                            if (!matches) { break; }
+                            ++height;
+                        }
+
+                        for (int row = y; row < y + height; ++row) { covered[row] |= run; }
+
+                        AddQuad(tilemap, mesh, first + glm::ivec2 {x, y}, {width, height}, id);
+                        x += width - 1;
+                    }
+                }
+            }
+        }
+
+        const size_t bytes = vertices.size() * sizeof(TileVertex);
+
+        if (!chunkMesh.vbo) { glCreateBuffers(1, &chunkMesh.vbo); }
+
+        if (bytes > chunkMesh.bytes)
+        {
+            glNamedBufferData(chunkMesh.vbo, static_cast<GLsizeiptr>(bytes), vertices.data(), GL_STATIC_DRAW);
+            chunkMesh.bytes = bytes;
+        }
+        else if (bytes)
+        {
+            glNamedBufferSubData(chunkMesh.vbo, 0, static_cast<GLsizeiptr>(bytes), vertices.data());
+        }
+
+        chunkMesh.quadCount = static_cast<uint32_t>(vertices.size() / 4);
+        chunkMesh.revision  = tilemap.ChunkRevision(chunk);
+    }
+
+    void TilemapRenderer::AddQuad(const Tilemap& tilemap, const MapMesh& mesh, glm::ivec2 tile, glm::ivec2 size, uint16_t id)
+    {
+        glm::vec2 uvMin;
+        glm::vec2 uvMax;
+        tilemap.atlas->TileUV(tilemap.tileSize, id, uvMin, uvMax);
+
+        const glm::vec4 rect   {uvMin.x, uvMin.y, uvMax.x - uvMin.x, uvMax.y - uvMin.y};
+        const float     depth  = static_cast<float>(tilemap.zLevel) * 0.01f;
+        const glm::vec2 repeat = size;
+        const glm::vec2 min    = mesh.origin + glm::vec2(tile) * tilemap.tileSize;
+        const glm::vec2 max    = min + repeat * tilemap.tileSize;
+
+        vertices.push_back({ {min.x, min.y}, {0.0f,     0.0f    }, rect, depth });
+        vertices.push_back({ {max.x, min.y}, {repeat.x, 0.0f    }, rect, depth });
+        vertices.push_back({ {max.x, max.y}, {repeat.x, repeat.y}, rect, depth });
+        vertices.push_back({ {min.x, max.y}, {0.0f,     repeat.y}, rect, depth });
+    }
+
+    void TilemapRenderer::Release(MapMesh& mesh) noexcept
+    {
+        for (ChunkMesh& chunkMesh : mesh.chunks)
+        {
+            if (chunkMesh.vbo) { glDeleteBuffers(1, &chunkMesh.vbo); }
+        }
+
+        mesh.chunks.clear();
+    }
+
+    void TilemapRenderer::ReportMemory(MemoryReport& report) const
+    {
+        size_t gpuBytes = 0;
+        for (const auto& [entity, mesh] : meshes)
+        {
+            for (const ChunkMesh& chunkMesh : mesh.chunks) { gpuBytes += chunkMesh.bytes; }
+        }
+
+        report.Add("Tilemap/staging", VectorMemory(vertices));
+        report.Add("Tilemap/gpu",     { gpuBytes, gpuBytes });
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef TERRANENGINE_TILEMAPRENDERER_H
+#define TERRANENGINE_TILEMAPRENDERER_H
+
+#include "engine/ecs/System.h"
+#include "engine/gfx/QuadIndexBuffer.h"
+#include "engine/gfx/ShaderLibrary.h"
+#include "engine/ecs/components/Components.h"
+#include "engine/ecs/world/World.h"
+
+#include <glad/gl.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TerranEngine
+{
+    /** Tile mesh vertex. `repeat` counts tiles across the quad, and the fragment shader wraps it to repeat one atlas tile (`tileRect`: UV min, UV size). */
+    struct TileVertex
+    {
+        glm::vec2 position;
+        glm::vec2 repeat;
+        glm::vec4 tileRect;
+        float     depth;
+    };
+
+    /**
+     * @brief Draws every Entity with a `Transform2D` and a `Tilemap` from vertex buffers built once per chunk.
+     *
+     * ### Chunk Meshes.
+     *
+     * Each `Tilemap::ChunkSize x ChunkSize` chunk owns a static vertex buffer holding its non-empty tiles, indexed by the shared `QuadIndexBuffer`.
+     * A chunk is only rebuilt when its `Tilemap::ChunkRevision` differs from the one it was built from (or the map moved, was resized or changed atlas),
+     * and only once it is visible, so static terrain costs a range check and one draw call per visible chunk.
+     *
+     * ### Merging.
+     *
+     * When `Tilemap::merge` is set, each chunk is meshed greedily: runs of identical tiles are grown into the largest rectangles they fill, and each
+     * rectangle becomes one quad whose UVs repeat its atlas tile (see `tile.frag`). Uniform floors collapse to a handful of quads per chunk instead
+     * of one per tile. Rectangles never cross chunk borders, so an edit only re-meshes its own chunk.
+     *
+     * ### Culling.
+     *
+     * Only chunks overlapping the primary camera's `viewMin`/`viewMax` bounds are drawn. Tilemaps ignore `Transform2D` rotation and scale.
+     *
+     * Registered in `SystemPhase::RENDER` ahead of the `SpriteRenderer`, so sprites on the same z-level draw over the terrain.
+     */
+    class TilemapRenderer final : public System
+    {
+    public:
+        TilemapRenderer();
+        ~TilemapRenderer();
+
+        TilemapRenderer(const TilemapRenderer&)            = delete;
+        TilemapRenderer& operator=(const TilemapRenderer&) = delete;
+
+        void Bind(World& world);
+        void Update(World& world, float deltaTime) override;
+        void ReportMemory(MemoryReport& report) const override;
+
+        /** Chunks drawn, quads drawn and chunks rebuilt during the last Update. */
+        [[nodiscard]] size_t DrawnChunks()   const noexcept { return drawnChunks; }
+        [[nodiscard]] size_t DrawnQuads()    const noexcept { return drawnQuads; }
+        [[nodiscard]] size_t RebuiltChunks() const noexcept { return rebuiltChunks; }
+
+    private:
+        struct ChunkMesh
+        {
+            GLuint   vbo       {0};
+            uint32_t revision  {0}; // Tilemap chunk revision the buffer was built from. 0 = needs building.
+            uint32_t quadCount {0};
+            size_t   bytes     {0}; // Allocated size of `vbo`.
+        };
+
+        /** GPU state of one Tilemap, and the settings its chunks were built with. */
+        struct MapMesh
+        {
+            std::vector<ChunkMesh> chunks;
+
+            glm::ivec2     chunkCount {0, 0};
+            glm::vec2      origin     {0.0f, 0.0f};
+            glm::vec2      tileSize   {0.0f, 0.0f};
+            const Texture* atlas      {nullptr};
+            int32_t        zLevel     {0};
+            bool           merge      {false};
+            uint32_t       stamp      {0};
+        };
+
+        void Prepare(MapMesh& mesh, const Transform2D& transform, const Tilemap& tilemap);
+        void BuildChunk(const Tilemap& tilemap, const MapMesh& mesh, glm::ivec2 chunk, ChunkMesh& chunkMesh);
+        void AddQuad(const Tilemap& tilemap, const MapMesh& mesh, glm::ivec2 tile, glm::ivec2 size, uint16_t id);
+        static void Release(MapMesh& mesh) noexcept;
+
+    private:
+        std::unordered_map<uint32_t, MapMesh> meshes; // Keyed by `Entity::Raw()`.
+        std::vector<TileVertex>               vertices; // Staging for chunk builds.
+
+        GLuint vao {0};
+
+        std::shared_ptr<const QuadIndexBuffer> indices {QuadIndexBuffer::Acquire()};
+        std::shared_ptr<const Shader>          shader  {ShaderLibrary::Acquire("tile.vert", "tile.frag")};
+
+        Query<Camera2D>             cameras;
+        Query<Transform2D, Tilemap> tilemaps;
+
+        uint32_t stamp         {0};
+        size_t   drawnChunks   {0};
+        size_t   drawnQuads    {0};
+        size_t   rebuiltChunks {0};
+    };
+}
+
+#endif // TERRANENGINE_TILEMAPRENDERER_H
@@ -0,0 +1,200 @@
+#include "engine/tiles/FieldOfView.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+namespace TerranEngine
+{
+    /** Floor of `numerator / denominator` for a positive denominator. */
+    static int FloorDiv(int numerator, int denominator) noexcept
+    {
+        const int quotient = numerator / denominator;
+        return (numerator % denominator != 0 && numerator < 0) ? quotient - 1 : quotient;
+    }
+
+    OpacityGrid::OpacityGrid(int width, int height) : width(std::max(width, 0)), height(std::max(height, 0))
+    {
+        wordsPerRow = (this->width + 63) / 64;
+        chunksX     = (this->width + ChunkSize - 1) / ChunkSize;
+        chunksY     = (this->height + ChunkSize - 1) / ChunkSize;
+
+        bits.assign(static_cast<size_t>(wordsPerRow) * this->height, 0);
+        chunkStamps.assign(static_cast<size_t>(chunksX) * chunksY, 0);
+    }
+
+    void OpacityGrid::SetOpaque(glm::ivec2 tile, bool opaque) noexcept
+    {
+        if (!InBounds(tile) || IsOpaque(tile) == opaque) { return; }
+
+        bits[static_cast<size_t>(tile.y) * wordsPerRow + (tile.x >> 6)] ^= uint64_t {1} << (tile.x & 63);
+        chunkStamps[static_cast<size_t>(tile.y / ChunkSize) * chunksX + tile.x / ChunkSize] = ++clock;
+    }
+
+    bool OpacityGrid::ChangedSince(glm::ivec2 min, glm::ivec2 max, uint64_t since) const noexcept
+    {
+        // Clamped to the grid before dividing, so an empty grid or an off-grid range checks no chunks rather than chunk 0.
+        const int minX = std::max(min.x, 0), maxX = std::min(max.x, width - 1);
+        const int minY = std::max(min.y, 0), maxY = std::min(max.y, height - 1);
+        if (minX > maxX || minY > maxY) { return false; }
+
+        const int firstX = minX / ChunkSize, lastX = maxX / ChunkSize;
+        const int firstY = minY / ChunkSize, lastY = maxY / ChunkSize;
+
+        for (int y = firstY; y <= lastY; ++y)
+        {
+            for (int x = firstX; x <= lastX; ++x)
+            {
+                if (chunkStamps[static_cast<size_t>(y) * chunksX + x] > since) { return true; }
+            }
+        }
+
+        return false;
+    }
+
+    void OpacityGrid::MarkAllChanged() noexcept
+    {
+        std::fill(chunkStamps.begin(), chunkStamps.end(), ++clock);
+    }
+
+    void OpacityGrid::ReportMemory(MemoryReport& report) const
+    {
+        report.Add("Opacity/bits",   VectorMemory(bits));
+        report.Add("Opacity/chunks", VectorMemory(chunkStamps));
+    }
+
+    void VisibilitySet::Reset(glm::ivec2 newOrigin, int newRadius)
+    {
+        origin = newOrigin;
+        radius = std::max(newRadius, 0);
+        side   = radius * 2 + 1;
+
+        bits.assign((static_cast<size_t>(side) * side + 63) / 64, 0);
+    }
+
+    size_t VisibilitySet::Count() const noexcept
+    {
+        size_t count = 0;
+        for (const uint64_t word : bits) { count += static_cast<size_t>(std::popcount(word)); }
+
+        return count;
+    }
+
+    void FieldOfView::Compute(const OpacityGrid& grid, glm::ivec2 origin, int radius, VisibilitySet& out)
+    {
+        out.Reset(origin, radius);
+        out.Set(origin);
+
+        for (int quadrant = 0; quadrant < 4; ++quadrant) { ScanQuadrant(grid, origin, std::max(radius, 0), quadrant, out); }
+    }
+
+    void FieldOfView::ScanQuadrant(const OpacityGrid& grid, glm::ivec2 origin, int radius, int quadrant, VisibilitySet& out)
+    {
+        // (depth, column) in quadrant space to a tile. Depth runs away from the origin, columns across.
+        const auto toTile = [origin, quadrant](int depth, int column) -> glm::ivec2
+        {
+            switch (quadrant)
+            {
+                case 0:  { return { origin.x + column, origin.y + depth }; }
+                case 1:  { return { origin.x + column, origin.y - depth }; }
+                case 2:  { return { origin.x + depth,  origin.y + column }; }
+                default: { return { origin.x - depth,  origin.y + column }; }
+            }
+        };
+
+        const int radiusSquared = radius * radius + radius; // `+ radius` rounds the circle out so edges are not jagged.
+
+        // Rows only depend on their own slopes, so pending rows can be scanned in any order.
+        rows.clear();
+        rows.push_back({1, -1, 1, 1, 1});
+
+        while (!rows.empty())
+        {
+            Row row = rows.back();
+            rows.pop_back();
+
+            if (row.depth > radius) { continue; }
+
+            // Columns with `depth * start <= column <= depth * end`, rounding ties inwards.
+            const int minColumn = FloorDiv(2 * row.depth * row.startNumerator + row.startDenominator, 2 * row.startDenominator);
+            const int maxColumn = -FloorDiv(row.endDenominator - 2 * row.depth * row.endNumerator, 2 * row.endDenominator);
+
+            bool hasPrevious    = false;
+            bool previousOpaque = false;
+
+            for (int column = minColumn; column <= maxColumn; ++column)
+            {
+                const glm::ivec2 tile   = toTile(row.depth, column);
+                const bool       opaque = grid.IsOpaque(tile);
+
+                // Floor tiles are only revealed when their centre is inside the slope range, which is what makes the result symmetric.
+                const bool symmetric = column * row.startDenominator >= row.depth * row.startNumerator && column * row.endDenominator <= row.depth * row.endNumerator;
+
+                if ((opaque || symmetric) && column * column + row.depth * row.depth <= radiusSquared) { out.Set(tile); }
+
+                // Slope of the tile's leading edge: (2 * column - 1) / (2 * depth).
+                if (hasPrevious && previousOpaque && !opaque)
+                {
+                    row.startNumerator   = 2 * column - 1;
+                    row.startDenominator = 2 * row.depth;
+                }
+
+                if (hasPrevious && !previousOpaque && opaque)
+                {
+                    rows.push_back({row.depth + 1, row.startNumerator, row.startDenominator, 2 * column - 1, 2 * row.depth});
+                }
+
+                hasPrevious    = true;
+                previousOpaque = opaque;
+            }
+
+            if (hasPrevious && !previousOpaque)
+            {
+                rows.push_back({row.depth + 1, row.startNumerator, row.startDenominator, row.endNumerator, row.endDenominator});
+            }
+        }
+    }
+
+    bool FieldOfView::HasLineOfSight(const OpacityGrid& grid, glm::ivec2 from, glm::ivec2 to) noexcept
+    {
+        const int stepsX = std::abs(to.x - from.x), signX = to.x > from.x ? 1 : -1;
+        const int stepsY = std::abs(to.y - from.y), signY = to.y > from.y ? 1 : -1;
+
+        glm::ivec2 tile = from;
+
+        for (int x = 0, y = 0; x < stepsX || y < stepsY;)
+        {
+            // Compares where the ray crosses the next vertical and horizontal tile edges, scaled to integers.
+            const int64_t decision = static_cast<int64_t>(1 + 2 * x) * stepsY - static_cast<int64_t>(1 + 2 * y) * stepsX;
+
+            if (decision == 0)
+            {
+                // Exactly through a corner: blocked only if both tiles beside it are opaque.
+                if (grid.IsOpaque({tile.x + signX, tile.y}) && grid.IsOpaque({tile.x, tile.y + signY})) { return false; }
+
+                tile.x += signX; ++x;
+                tile.y += signY; ++y;
+            }
+            else if (decision < 0) { tile.x += signX; ++x; }
+            else                   { tile.y += signY; ++y; }
+
+            if (tile != to && grid.IsOpaque(tile)) { return false; }
+        }
+
+        return true;
+    }
+
+    size_t FieldOfView::CastRays(const OpacityGrid& grid, glm::ivec2 origin, std::span<const glm::ivec2> targets, std::span<uint8_t> results) noexcept
+    {
+        const size_t count   = std::min(targets.size(), results.size());
+        size_t       visible = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = HasLineOfSight(grid, origin, targets[i]) ? 1 : 0;
+            visible   += results[i];
+        }
+
+        return visible;
+    }
+}
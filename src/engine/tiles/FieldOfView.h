@@ -0,0 +1,206 @@
+#ifndef TERRANENGINE_FIELDOFVIEW_H
+#define TERRANENGINE_FIELDOFVIEW_H
+
+#include "engine/core/MemoryReport.h"
+#include "engine/tiles/TileChunkMap.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Bitset of opaque tiles over a `width x height` tile map, with per-chunk change stamps.
+     *
+     * Every `ChunkSize x ChunkSize` block of tiles records the stamp of its last opacity change, so a cached visibility result
+     * can tell whether anything near it changed with a handful of comparisons. Tiles outside the map count as opaque.
+     */
+    class OpacityGrid
+    {
+    public:
+        static constexpr int ChunkSize = 16;
+
+        OpacityGrid() = default;
+        OpacityGrid(int width, int height);
+
+        /** Rebuild from row-major tile IDs, where `isOpaque(tileID)` decides each tile's opacity. */
+        template<typename IsOpaque>
+        void Assign(int newWidth, int newHeight, std::span<const uint16_t> tiles, IsOpaque&& isOpaque)
+        {
+            // The clock carries over, so results computed against the old grid are still seen as stale.
+            const uint64_t previousClock = clock;
+
+            *this = OpacityGrid(newWidth, newHeight);
+            clock = previousClock;
+            MarkAllChanged();
+
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const size_t index = static_cast<size_t>(y) * width + x;
+                    if (index < tiles.size() && isOpaque(tiles[index])) { SetBit({x, y}); }
+                }
+            }
+        }
+
+        /** Rebuild from a chunked map (e.g. `Map::tiles`) a chunk at a time, asking `isOpaque` once for a uniform chunk. */
+        template<typename IsOpaque>
+        void Assign(const TileChunkMap& tiles, IsOpaque&& isOpaque)
+        {
+            const uint64_t previousClock = clock;
+
+            *this = OpacityGrid(tiles.Width(), tiles.Height());
+            clock = previousClock;
+            MarkAllChanged();
+
+            std::array<uint16_t, TileChunkMap::ChunkArea> ids;
+
+            for (int chunkY = 0; chunkY < tiles.ChunksY(); ++chunkY)
+            {
+                for (int chunkX = 0; chunkX < tiles.ChunksX(); ++chunkX)
+                {
+                    const glm::ivec2 first = glm::ivec2 {chunkX, chunkY} * TileChunkMap::ChunkSize;
+                    const glm::ivec2 end   = glm::min(first + TileChunkMap::ChunkSize, glm::ivec2 {width, height});
+
+                    uint16_t   uniformID = 0;
+                    const bool uniform   = tiles.IsUniform({chunkX, chunkY}, uniformID);
+
+                    if (uniform && !isOpaque(uniformID)) { continue; }
+                    if (!uniform) { tiles.ReadChunk({chunkX, chunkY}, ids); }
+
+                    for (int y = first.y; y < end.y; ++y)
+                    {
+                        for (int x = first.x; x < end.x; ++x)
+                        {
+                            if (uniform || isOpaque(ids[static_cast<size_t>(y - first.y) * TileChunkMap::ChunkSize + (x - first.x)])) { SetBit({x, y}); }
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Change a tile's opacity, stamping its chunk if the value changed. */
+        void SetOpaque(glm::ivec2 tile, bool opaque) noexcept;
+
+        [[nodiscard]] bool IsOpaque(glm::ivec2 tile) const noexcept
+        {
+            if (!InBounds(tile)) { return true; }
+            return (bits[static_cast<size_t>(tile.y) * wordsPerRow + (tile.x >> 6)] >> (tile.x & 63)) & 1u;
+        }
+
+        /** True if any tile in `[min, max]` changed opacity after `since`. */
+        [[nodiscard]] bool ChangedSince(glm::ivec2 min, glm::ivec2 max, uint64_t since) const noexcept;
+
+        [[nodiscard]] bool     InBounds(glm::ivec2 tile) const noexcept { return tile.x >= 0 && tile.y >= 0 && tile.x < width && tile.y < height; }
+        [[nodiscard]] uint64_t Stamp()                   const noexcept { return clock; }
+        [[nodiscard]] int      Width()                   const noexcept { return width; }
+        [[nodiscard]] int      Height()                  const noexcept { return height; }
+
+        void ReportMemory(MemoryReport& report) const;
+
+    private:
+        void SetBit(glm::ivec2 tile) noexcept { bits[static_cast<size_t>(tile.y) * wordsPerRow + (tile.x >> 6)] |= uint64_t {1} << (tile.x & 63); }
+        void MarkAllChanged() noexcept;
+
+    private:
+        std::vector<uint64_t> bits;        // One bit per tile, rows padded to whole words.
+        std::vector<uint64_t> chunkStamps; // Stamp of the last change in each chunk, row-major.
+
+        int      width       {0};
+        int      height      {0};
+        int      wordsPerRow {0};
+        int      chunksX     {0};
+        int      chunksY     {0};
+        uint64_t clock       {0};
+    };
+
+    /** Compact set of visible tiles within `radius` of an origin tile, one bit per tile of the surrounding square. */
+    class VisibilitySet
+    {
+    public:
+        /** Empty the set and re-centre it. */
+        void Reset(glm::ivec2 newOrigin, int newRadius);
+
+        void Set(glm::ivec2 tile) noexcept
+        {
+            const int bit = BitOf(tile);
+            if (bit >= 0) { bits[static_cast<size_t>(bit) >> 6] |= uint64_t {1} << (bit & 63); }
+        }
+
+        [[nodiscard]] bool IsVisible(glm::ivec2 tile) const noexcept
+        {
+            const int bit = BitOf(tile);
+            return bit >= 0 && ((bits[static_cast<size_t>(bit) >> 6] >> (bit & 63)) & 1u);
+        }
+
+        [[nodiscard]] size_t     Count()  const noexcept;
+        [[nodiscard]] glm::ivec2 Origin() const noexcept { return origin; }
+        [[nodiscard]] int        Radius() const noexcept { return radius; }
+
+        [[nodiscard]] const std::vector<uint64_t>& Bits() const noexcept { return bits; }
+
+    private:
+        [[nodiscard]] int BitOf(glm::ivec2 tile) const noexcept
+        {
+            const glm::ivec2 local = tile - origin + radius;
+            return (radius >= 0 && local.x >= 0 && local.y >= 0 && local.x < side && local.y < side) ? local.y * side + local.x : -1;
+        }
+
+    private:
+        std::vector<uint64_t> bits;
+        glm::ivec2 origin {0, 0};
+        int        radius {-1}; // Negative until the first `Reset`, so a fresh set never matches a viewer.
+        int        side   {0};
+    };
+
+    /**
+     * @brief Grid visibility queries over an `OpacityGrid`.
+     *
+     * ### Field Of View.
+     *
+     * `Compute` uses symmetric shadowcasting: each quadrant is scanned row by row outwards from the origin, narrowing the visible slope range at every opaque tile.
+     * Slopes are kept as exact fractions, so results are symmetric (A sees B exactly when B sees A) and free of floating-point artefacts. Opaque tiles that bound
+     * the visible area are included, so walls are visible.
+     *
+     * ### Line Of Sight.
+     *
+     * `HasLineOfSight` walks the tiles between two tile centres with an integer supercover DDA. A ray passing exactly through a corner is only blocked if both tiles
+     * beside the corner are opaque. `CastRays` runs a batch of rays from one origin.
+     *
+     * A `FieldOfView` keeps its scratch storage between calls, so repeated queries do not allocate. It is not thread-safe; use one per thread.
+     */
+    class FieldOfView
+    {
+    public:
+        /** Fill `out` with every tile visible from `origin` within the circle of `radius` tiles. */
+        void Compute(const OpacityGrid& grid, glm::ivec2 origin, int radius, VisibilitySet& out);
+
+        /** True if no opaque tile lies strictly between `from` and `to`. */
+        [[nodiscard]] static bool HasLineOfSight(const OpacityGrid& grid, glm::ivec2 from, glm::ivec2 to) noexcept;
+
+        /** Writes 1 to `results[i]` if `targets[i]` is visible from `origin`, 0 otherwise. Returns the number of visible targets. */
+        static size_t CastRays(const OpacityGrid& grid, glm::ivec2 origin, std::span<const glm::ivec2> targets, std::span<uint8_t> results) noexcept;
+
+    private:
+        /** A row of a quadrant scan: `depth` tiles out from the origin, between two slopes stored as fractions over `2 * depth`. */
+        struct Row
+        {
+            int depth;
+            int startNumerator;
+            int startDenominator;
+            int endNumerator;
+            int endDenominator;
+        };
+
+        void ScanQuadrant(const OpacityGrid& grid, glm::ivec2 origin, int radius, int quadrant, VisibilitySet& out);
+
+        std::vector<Row> rows;
+    };
+}
+
+#endif // TERRANENGINE_FIELDOFVIEW_H
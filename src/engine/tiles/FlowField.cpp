@@ -0,0 +1,338 @@
+#include "engine/tiles/FlowField.h"
+
+#include "engine/core/Log.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace TerranEngine
+{
+    CostGrid::CostGrid(int width, int height, uint8_t cost) : width(std::max(width, 0)), height(std::max(height, 0))
+    {
+        costs.assign(static_cast<size_t>(Stride()) * static_cast<size_t>(this->height + 2), Blocked);
+
+        for (int y = 0; y < this->height; ++y)
+        {
+            std::fill_n(costs.begin() + Index({0, y}), this->width, cost ? cost : 1);
+        }
+    }
+
+    void FlowField::Build(const CostGrid& grid, glm::ivec2 newTarget)
+    {
+        width  = grid.Width();
+        height = grid.Height();
+        stride = grid.Stride();
+        target = newTarget;
+
+        integration.assign(grid.Padded().size(), Unreachable);
+        directions.assign(static_cast<size_t>(width) * static_cast<size_t>(height), None);
+
+        if (!grid.InBounds(target) || grid.Get(target) == CostGrid::Blocked) { return; }
+
+        // Dial's algorithm: distances popped in increasing order from a ring of buckets, one bucket per distance.
+        buckets.resize(BucketCount);
+
+        const std::vector<uint8_t>& costs = grid.Padded();
+        const int32_t offsets[4] = { 1, -1, stride, -stride };
+
+        const uint32_t start = grid.Index(target);
+        integration[start] = 0;
+        buckets[0].push_back(start);
+
+        size_t pending = 1;
+        for (uint32_t distance = 0; pending; ++distance)
+        {
+            // Pushes always land `cost >= 1` buckets ahead, so this bucket does not grow while it is walked.
+            std::vector<uint32_t>& bucket = buckets[distance % BucketCount];
+
+            for (const uint32_t index : bucket)
+            {
+                --pending;
+                if (integration[index] != distance) { continue; } // Superseded by a cheaper entry.
+
+                for (const int32_t offset : offsets)
+                {
+                    const uint32_t neighbour = index + offset;
+                    const uint8_t  cost      = costs[neighbour];
+                    if (cost == CostGrid::Blocked) { continue; }
+
+                    const uint32_t candidate = distance + cost;
+                    if (candidate < integration[neighbour])
+                    {
+                        integration[neighbour] = candidate;
+                        buckets[candidate % BucketCount].push_back(neighbour);
+                        ++pending;
+                    }
+                }
+            }
+
+            bucket.clear();
+        }
+
+        UpdateDirections({0, 0}, {width - 1, height - 1});
+    }
+
+    void FlowField::Repair(const CostGrid& grid, std::span<const uint32_t> changedTiles)
+    {
+        if (changedTiles.empty()) { return; }
+
+        // A changed target, or a field built for another grid, cannot be repaired locally.
+        const uint32_t start = grid.Index(target);
+        if (grid.Width() != width || grid.Height() != height || std::ranges::find(changedTiles, start) != changedTiles.end())
+        {
+            Build(grid, target);
+            return;
+        }
+
+        const std::vector<uint8_t>& costs = grid.Padded();
+        const int32_t offsets[4] = { 1, -1, stride, -stride };
+
+        marks.resize(integration.size(), 0);
+        affected.clear();
+        heap.clear();
+
+        dirtyMin = {width, height};
+        dirtyMax = {-1, -1};
+
+        // 1. Collect every tile whose integrated cost may have been derived through a changed tile.
+        for (const uint32_t index : changedTiles)
+        {
+            if (!marks[index]) { marks[index] = 1; affected.push_back(index); }
+        }
+
+        for (size_t i = 0; i < affected.size(); ++i)
+        {
+            const uint32_t distance = integration[affected[i]];
+            if (distance == Unreachable) { continue; }
+
+            for (const int32_t offset : offsets)
+            {
+                const uint32_t neighbour = affected[i] + offset;
+                if (marks[neighbour] || integration[neighbour] == Unreachable) { continue; }
+
+                if (integration[neighbour] == distance + costs[neighbour])
+                {
+                    marks[neighbour] = 1;
+                    affected.push_back(neighbour);
+                }
+            }
+        }
+
+        for (const uint32_t index : affected)
+        {
+            integration[index] = Unreachable;
+            Touch(index);
+        }
+
+        // 2. Seed each affected tile from its unaffected neighbours, which still hold valid costs.
+        for (const uint32_t index : affected)
+        {
+            if (costs[index] == CostGrid::Blocked) { continue; }
+
+            uint32_t best = Unreachable;
+            for (const int32_t offset : offsets)
+            {
+                const uint32_t neighbour = index + offset;
+                if (!marks[neighbour] && integration[neighbour] != Unreachable) { best = std::min(best, integration[neighbour] + costs[index]); }
+            }
+
+            if (best != Unreachable)
+            {
+                integration[index] = best;
+                heap.push_back((static_cast<uint64_t>(best) << 32) | index);
+            }
+        }
+
+        for (const uint32_t index : affected) { marks[index] = 0; }
+
+        // 3. Resolve with Dijkstra. Lowered costs also flow out into tiles that were not affected.
+        std::ranges::make_heap(heap, std::greater<>{});
+        Integrate(grid);
+
+        if (dirtyMax.x >= 0)
+        {
+            UpdateDirections(glm::max(dirtyMin - 1, glm::ivec2 {0, 0}), glm::min(dirtyMax + 1, glm::ivec2 {width - 1, height - 1}));
+        }
+    }
+
+    void FlowField::Integrate(const CostGrid& grid)
+    {
+        const std::vector<uint8_t>& costs = grid.Padded();
+        const int32_t offsets[4] = { 1, -1, stride, -stride };
+
+        while (!heap.empty())
+        {
+            std::ranges::pop_heap(heap, std::greater<>{});
+            const uint64_t entry = heap.back();
+            heap.pop_back();
+
+            const uint32_t distance = static_cast<uint32_t>(entry >> 32);
+            const uint32_t index    = static_cast<uint32_t>(entry);
+            if (integration[index] != distance) { continue; }
+
+            for (const int32_t offset : offsets)
+            {
+                const uint32_t neighbour = index + offset;
+                const uint8_t  cost      = costs[neighbour];
+                if (cost == CostGrid::Blocked) { continue; }
+
+                const uint32_t candidate = distance + cost;
+                if (candidate < integration[neighbour])
+                {
+                    integration[neighbour] = candidate;
+                    Touch(neighbour);
+
+                    heap.push_back((static_cast<uint64_t>(candidate) << 32) | neighbour);
+                    std::ranges::push_heap(heap, std::greater<>{});
+                }
+            }
+        }
+    }
+
+    void FlowField::Touch(uint32_t index) noexcept
+    {
+        const glm::ivec2 tile {static_cast<int>(index % stride) - 1, static_cast<int>(index / stride) - 1};
+
+        dirtyMin = glm::min(dirtyMin, tile);
+        dirtyMax = glm::max(dirtyMax, tile);
+    }
+
+    void FlowField::UpdateDirections(glm::ivec2 min, glm::ivec2 max)
+    {
+        for (int y = min.y; y <= max.y; ++y)
+        {
+            // Rows above, at and below `y` in the padded field. The border keeps every neighbour read in bounds.
+            const uint32_t* below = &integration[static_cast<size_t>(y) * stride + 1];
+            const uint32_t* row   = below + stride;
+            const uint32_t* above = row + stride;
+
+            uint8_t* directionRow = &directions[static_cast<size_t>(y) * width];
+
+            for (int x = min.x; x <= max.x; ++x)
+            {
+                const uint32_t here = row[x];
+                if (here == 0 || here == Unreachable) { directionRow[x] = None; continue; }
+
+                const uint32_t east = row[x + 1], west = row[x - 1], north = above[x], south = below[x];
+
+                // Diagonals must not squeeze between two unreachable tiles.
+                const uint32_t northEast = (north != Unreachable && east != Unreachable) ? above[x + 1] : Unreachable;
+                const uint32_t northWest = (north != Unreachable && west != Unreachable) ? above[x - 1] : Unreachable;
+                const uint32_t southWest = (south != Unreachable && west != Unreachable) ? below[x - 1] : Unreachable;
+                const uint32_t southEast = (south != Unreachable && east != Unreachable) ? below[x + 1] : Unreachable;
+
+                // Same order as `DirectionVectors`.
+                const uint32_t candidates[8] = { east, northEast, north, northWest, west, southWest, south, southEast };
+
+                uint32_t best      = here;
+                uint8_t  direction = None;
+
+                for (uint8_t i = 0; i < 8; ++i)
+                {
+                    if (candidates[i] < best) { best = candidates[i]; direction = i; }
+                }
+
+                directionRow[x] = direction;
+            }
+        }
+    }
+
+    void FlowField::ReportMemory(MemoryReport& report) const
+    {
+        MemoryUsage scratch = VectorMemory(heap);
+        scratch += VectorMemory(affected);
+        scratch += VectorMemory(marks);
+        for (const std::vector<uint32_t>& bucket : buckets) { scratch += VectorMemory(bucket); }
+
+        report.Add("FlowField/integration", VectorMemory(integration));
+        report.Add("FlowField/directions",  VectorMemory(directions));
+        report.Add("FlowField/scratch",     scratch);
+    }
+
+    FlowFieldCache::FlowFieldCache(int width, int height, size_t capacity) : grid(width, height), capacity(std::max<size_t>(capacity, 1))
+    {
+        entries.reserve(this->capacity);
+    }
+
+    void FlowFieldCache::SetCosts(std::span<const uint8_t> costs)
+    {
+        if (costs.size() != static_cast<size_t>(grid.Width()) * static_cast<size_t>(grid.Height()))
+        {
+            TE_LOG_ERROR("FlowFieldCache: Expected {} tile costs, got {}.", grid.Width() * grid.Height(), costs.size());
+            return;
+        }
+
+        for (int y = 0; y < grid.Height(); ++y)
+        {
+            for (int x = 0; x < grid.Width(); ++x) { grid.Set({x, y}, costs[static_cast<size_t>(y) * grid.Width() + x]); }
+        }
+
+        Clear();
+    }
+
+    void FlowFieldCache::SetCost(glm::ivec2 tile, uint8_t cost)
+    {
+        if (!grid.InBounds(tile) || grid.Get(tile) == (cost ? cost : 1)) { return; }
+
+        grid.Set(tile, cost);
+        changes.push_back(grid.Index(tile));
+    }
+
+    const FlowField* FlowFieldCache::Get(glm::ivec2 target)
+    {
+        if (!grid.InBounds(target)) { return nullptr; }
+
+        const size_t changeCount = changeBase + changes.size();
+
+        auto entry = std::ranges::find_if(entries, [target](const Entry& cached) { return cached.field.Target() == target; });
+        if (entry != entries.end())
+        {
+            const size_t pending = changeCount - entry->seenChanges;
+
+            // Past a certain number of changes a repair touches most of the map anyway.
+            if (pending > static_cast<size_t>(grid.Width() * grid.Height()) / 16) { entry->field.Build(grid, target); }
+            else if (pending)                                                     { entry->field.Repair(grid, std::span(changes).subspan(entry->seenChanges - changeBase)); }
+        }
+        else
+        {
+            if (entries.size() < capacity) { entries.emplace_back(); entry = entries.end() - 1; }
+            else                           { entry = std::ranges::min_element(entries, {}, &Entry::lastUsed); }
+
+            entry->field.Build(grid, target);
+        }
+
+        entry->seenChanges = changeCount;
+        entry->lastUsed    = ++useClock;
+
+        TrimChanges();
+        return &entry->field;
+    }
+
+    void FlowFieldCache::TrimChanges()
+    {
+        // Only changes that some cached field has not seen yet need to be kept.
+        size_t oldest = changeBase + changes.size();
+        for (const Entry& entry : entries) { oldest = std::min(oldest, entry.seenChanges); }
+
+        if (oldest > changeBase)
+        {
+            changes.erase(changes.begin(), changes.begin() + static_cast<std::ptrdiff_t>(oldest - changeBase));
+            changeBase = oldest;
+        }
+    }
+
+    void FlowFieldCache::Clear() noexcept
+    {
+        entries.clear();
+        changeBase += changes.size();
+        changes.clear();
+    }
+
+    void FlowFieldCache::ReportMemory(MemoryReport& report) const
+    {
+        report.Add("FlowFieldCache/costs",   VectorMemory(grid.Padded()));
+        report.Add("FlowFieldCache/changes", VectorMemory(changes));
+
+        for (const Entry& entry : entries) { entry.field.ReportMemory(report); }
+    }
+}
@@ -0,0 +1,216 @@
+#ifndef TERRANENGINE_FLOWFIELD_H
+#define TERRANENGINE_FLOWFIELD_H
+
+#include "engine/core/MemoryReport.h"
+#include "engine/math/Grid.h"
+#include "engine/tiles/TileChunkMap.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Per-tile movement costs of a `width x height` tile map.
+     *
+     * Costs are stored row-major with a one tile border of `Blocked` on every side, so neighbour lookups never need a bounds check.
+     * `Index()` converts a tile coordinate into that padded layout.
+     */
+    class CostGrid
+    {
+    public:
+        static constexpr uint8_t Blocked = 255;
+
+        CostGrid() = default;
+        CostGrid(int width, int height, uint8_t cost = 1);
+
+        /** Costs of a chunked map (e.g. `Map::tiles`), where `costOf(tileID)` gives each tile's cost. Read a chunk at a time, with one `costOf` per uniform chunk. */
+        template<typename CostOf>
+        CostGrid(const TileChunkMap& tiles, CostOf&& costOf) : CostGrid(tiles.Width(), tiles.Height())
+        {
+            std::array<uint16_t, TileChunkMap::ChunkArea> ids;
+
+            for (int chunkY = 0; chunkY < tiles.ChunksY(); ++chunkY)
+            {
+                for (int chunkX = 0; chunkX < tiles.ChunksX(); ++chunkX)
+                {
+                    const glm::ivec2 first = glm::ivec2 {chunkX, chunkY} * TileChunkMap::ChunkSize;
+                    const glm::ivec2 end   = glm::min(first + TileChunkMap::ChunkSize, glm::ivec2 {width, height});
+
+                    uint16_t      uniformID   = 0;
+                    const bool    uniform     = tiles.IsUniform({chunkX, chunkY}, uniformID);
+                    const uint8_t uniformCost = uniform ? static_cast<uint8_t>(costOf(uniformID)) : 0;
+
+                    if (!uniform) { tiles.ReadChunk({chunkX, chunkY}, ids); }
+
+                    for (int y = first.y; y < end.y; ++y)
+                    {
+                        for (int x = first.x; x < end.x; ++x)
+                        {
+                            Set({x, y}, uniform ? uniformCost : static_cast<uint8_t>(costOf(ids[static_cast<size_t>(y - first.y) * TileChunkMap::ChunkSize + (x - first.x)])));
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Set the cost of entering a tile. Costs are clamped to `[1, Blocked]`. */
+        void Set(glm::ivec2 tile, uint8_t cost) noexcept { costs[Index(tile)] = cost ? cost : 1; }
+
+        [[nodiscard]] uint8_t  Get(glm::ivec2 tile)      const noexcept { return costs[Index(tile)]; }
+        [[nodiscard]] bool     InBounds(glm::ivec2 tile) const noexcept { return tile.x >= 0 && tile.y >= 0 && tile.x < width && tile.y < height; }
+        [[nodiscard]] uint32_t Index(glm::ivec2 tile)    const noexcept { return static_cast<uint32_t>((tile.y + 1) * Stride() + tile.x + 1); }
+
+        [[nodiscard]] int Width()  const noexcept { return width; }
+        [[nodiscard]] int Height() const noexcept { return height; }
+        [[nodiscard]] int Stride() const noexcept { return width + 2; }
+
+        [[nodiscard]] const std::vector<uint8_t>& Padded() const noexcept { return costs; }
+
+    private:
+        std::vector<uint8_t> costs;
+        int width  {0};
+        int height {0};
+    };
+
+    /**
+     * @brief Integration and direction fields leading every tile of a `CostGrid` towards a single target tile.
+     *
+     * ### Integration.
+     *
+     * The integration field holds the cheapest total cost from each tile to the target over 4-connected moves, where entering a tile costs its `CostGrid` value.
+     * Full builds use Dial's bucket queue (costs are small integers), which is linear in the tile count.
+     *
+     * ### Directions.
+     *
+     * Each tile stores the 8-connected neighbour with the lowest integrated cost, computed row by row over the padded field without bounds checks.
+     * Diagonals are only taken when both orthogonal tiles they pass between are reachable, so agents never cut wall corners.
+     *
+     * ### Repair.
+     *
+     * `Repair` updates the field after tile costs change without a full rebuild: every tile whose cost could depend on a changed tile is reset,
+     * re-seeded from its untouched neighbours, and resolved with Dijkstra. Only directions around tiles whose cost changed are recomputed.
+     */
+    class FlowField
+    {
+    public:
+        static constexpr uint32_t Unreachable = 0xFFFFFFFFu;
+        static constexpr uint8_t  None        = 8;
+
+        /** Integrate the whole field towards `target`. A blocked or out-of-bounds target leaves every tile unreachable. */
+        void Build(const CostGrid& grid, glm::ivec2 target);
+
+        /** Bring the field up to date after the tiles at the padded indices `changedTiles` changed cost in `grid`. */
+        void Repair(const CostGrid& grid, std::span<const uint32_t> changedTiles);
+
+        /** Total cost from `tile` to the target, or `Unreachable`. */
+        [[nodiscard]] uint32_t Distance(glm::ivec2 tile) const noexcept
+        {
+            return InBounds(tile) ? integration[static_cast<size_t>((tile.y + 1) * stride + tile.x + 1)] : Unreachable;
+        }
+
+        /** Unit direction to step in from `tile`. Zero at the target, and on unreachable or out-of-bounds tiles. */
+        [[nodiscard]] glm::vec2 Direction(glm::ivec2 tile) const noexcept
+        {
+            return InBounds(tile) ? DirectionVectors[directions[static_cast<size_t>(tile.y * width + tile.x)]] : glm::vec2 {0.0f, 0.0f};
+        }
+
+        /** `Direction` of the tile under a world-pixel position. */
+        [[nodiscard]] glm::vec2 Sample(const glm::vec2& worldPosition, int tilePx = 16) const noexcept { return Direction(WorldToGrid(worldPosition, tilePx)); }
+
+        [[nodiscard]] bool       InBounds(glm::ivec2 tile) const noexcept { return tile.x >= 0 && tile.y >= 0 && tile.x < width && tile.y < height; }
+        [[nodiscard]] glm::ivec2 Target()                  const noexcept { return target; }
+
+        void ReportMemory(MemoryReport& report) const;
+
+    private:
+        void Integrate(const CostGrid& grid);
+        void UpdateDirections(glm::ivec2 min, glm::ivec2 max);
+        void Touch(uint32_t index) noexcept;
+
+    private:
+        static constexpr size_t BucketCount = 256; // Greater than the largest step cost, so live distances never share a bucket.
+
+        static constexpr glm::vec2 DirectionVectors[9] =
+        {
+            { 1.0f, 0.0f}, { 0.70710678f,  0.70710678f}, {0.0f,  1.0f}, {-0.70710678f,  0.70710678f},
+            {-1.0f, 0.0f}, {-0.70710678f, -0.70710678f}, {0.0f, -1.0f}, { 0.70710678f, -0.70710678f},
+            { 0.0f, 0.0f}
+        };
+
+        std::vector<uint32_t> integration; // Padded like the CostGrid. Border tiles stay `Unreachable`.
+        std::vector<uint8_t>  directions;  // Unpadded, row-major. Index into `DirectionVectors`.
+
+        // Scratch storage reused between builds and repairs.
+        std::vector<std::vector<uint32_t>> buckets;
+        std::vector<uint64_t>              heap;     // (distance << 32) | index, as a min-heap.
+        std::vector<uint32_t>              affected;
+        std::vector<uint8_t>               marks;
+
+        glm::ivec2 target   {0, 0};
+        glm::ivec2 dirtyMin {0, 0};
+        glm::ivec2 dirtyMax {0, 0};
+
+        int width  {0};
+        int height {0};
+        int stride {0};
+    };
+
+    /**
+     * @brief Shared flow fields for a tile map, cached per target tile.
+     *
+     * Any number of agents heading to the same tile read one cached field, so the cost of a search is paid once per target rather than once per agent.
+     * The least recently used field is evicted when the cache is full.
+     *
+     * Cost changes are logged rather than applied straight away. A cached field repairs itself against the changes it has not seen yet the next time it is requested.
+     * If too many changes are pending, it is rebuilt from scratch instead.
+     */
+    class FlowFieldCache
+    {
+    public:
+        static constexpr size_t DefaultCapacity = 16;
+
+        FlowFieldCache(int width, int height, size_t capacity = DefaultCapacity);
+
+        /** Replace every tile cost (`width * height`, row-major). Drops every cached field. */
+        void SetCosts(std::span<const uint8_t> costs);
+
+        /** Change the cost of one tile. Cached fields are repaired lazily. */
+        void SetCost(glm::ivec2 tile, uint8_t cost);
+
+        [[nodiscard]] uint8_t         Cost(glm::ivec2 tile) const noexcept { return grid.InBounds(tile) ? grid.Get(tile) : CostGrid::Blocked; }
+        [[nodiscard]] const CostGrid& Grid()                const noexcept { return grid; }
+
+        /** The field leading to `target`, built or repaired as needed. Returns `nullptr` when `target` is outside the map. */
+        [[nodiscard]] const FlowField* Get(glm::ivec2 target);
+
+        void Clear() noexcept;
+        void ReportMemory(MemoryReport& report) const;
+
+    private:
+        struct Entry
+        {
+            FlowField field;
+            uint64_t  lastUsed    {0};
+            size_t    seenChanges {0}; // Position in the change log this field is up to date with.
+        };
+
+        void TrimChanges();
+
+    private:
+        CostGrid           grid;
+        std::vector<Entry> entries;
+
+        std::vector<uint32_t> changes;        // Padded indices of changed tiles, oldest first.
+        size_t                changeBase {0}; // Total changes trimmed from the front of `changes`.
+
+        size_t   capacity {DefaultCapacity};
+        uint64_t useClock {0};
+    };
+}
+
+#endif // TERRANENGINE_FLOWFIELD_H
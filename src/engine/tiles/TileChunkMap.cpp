@@ -0,0 +1,290 @@
+#include "engine/tiles/TileChunkMap.h"
+
+#include <algorithm>
+#include <array>
+
+namespace TerranEngine
+{
+    static constexpr size_t MAX_PALETTE = 256;
+
+    TileChunkMap::TileChunkMap(int width, int height, uint16_t fill)
+    {
+        Assign(width, height, {}, fill);
+    }
+
+    void TileChunkMap::Assign(int newWidth, int newHeight, std::span<const uint16_t> tiles, uint16_t fill)
+    {
+        width   = std::max(newWidth, 0);
+        height  = std::max(newHeight, 0);
+        chunksX = (width + ChunkSize - 1) / ChunkSize;
+        chunksY = (height + ChunkSize - 1) / ChunkSize;
+
+        chunks.clear();
+        chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+
+        std::array<uint16_t, ChunkArea> buffer;
+
+        for (int y = 0; y < chunksY; ++y)
+        {
+            for (int x = 0; x < chunksX; ++x)
+            {
+                Gather({x, y}, tiles, fill, buffer.data());
+                Encode(chunks[static_cast<size_t>(y) * chunksX + x], buffer.data());
+            }
+        }
+    }
+
+    void TileChunkMap::Set(glm::ivec2 tile, uint16_t id)
+    {
+        if (!InBounds(tile)) { return; }
+
+        Chunk&         chunk = chunks[static_cast<size_t>(tile.y / ChunkSize) * chunksX + tile.x / ChunkSize];
+        const uint32_t local = static_cast<uint32_t>((tile.y % ChunkSize) * ChunkSize + tile.x % ChunkSize);
+
+        if (Decode(chunk, local) == id) { return; }
+
+        // 1. Find or add the palette entry, if the current width has room for it.
+        uint32_t index = id;
+        bool     fits  = chunk.bits == 16;
+
+        if (chunk.bits && !fits)
+        {
+            const auto entry = std::ranges::find(chunk.palette, id);
+            index = static_cast<uint32_t>(entry - chunk.palette.begin());
+
+            if (entry != chunk.palette.end())                { fits = true; }
+            else if (chunk.palette.size() < 1u << chunk.bits) { chunk.palette.push_back(id); fits = true; }
+        }
+
+        if (fits)
+        {
+            const uint32_t bit   = local * chunk.bits;
+            const uint32_t shift = bit & 63;
+            const uint64_t mask  = ((uint64_t {1} << chunk.bits) - 1u) << shift;
+
+            uint64_t& word = chunk.words[bit >> 6];
+            word = (word & ~mask) | (static_cast<uint64_t>(index) << shift);
+            return;
+        }
+
+        // 2. Otherwise re-encode the chunk at a wider width.
+        std::array<uint16_t, ChunkArea> buffer;
+        DecodeRange(chunk, 0, ChunkArea, buffer.data());
+        buffer[local] = id;
+        Encode(chunk, buffer.data());
+    }
+
+    void TileChunkMap::Compact()
+    {
+        std::array<uint16_t, ChunkArea> buffer;
+
+        for (Chunk& chunk : chunks)
+        {
+            if (!chunk.bits) { continue; }
+
+            DecodeRange(chunk, 0, ChunkArea, buffer.data());
+            Encode(chunk, buffer.data());
+        }
+    }
+
+    void TileChunkMap::ReadRow(int y, int x, std::span<uint16_t> out, uint16_t outside) const noexcept
+    {
+        if (y < 0 || y >= height)
+        {
+            std::ranges::fill(out, outside);
+            return;
+        }
+
+        const int64_t end   = static_cast<int64_t>(x) + static_cast<int64_t>(out.size());
+        const int     first = std::clamp(x, 0, width);
+        const int     last  = static_cast<int>(std::clamp<int64_t>(end, first, width));
+
+        // Columns left and right of the map.
+        const size_t before = static_cast<size_t>(std::clamp<int64_t>(static_cast<int64_t>(first) - x, 0, static_cast<int64_t>(out.size())));
+        const size_t after  = static_cast<size_t>(last - first) + before;
+
+        std::fill(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(before), outside);
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(after), out.end(), outside);
+
+        // Columns inside the map, one chunk at a time.
+        const Chunk*   row   = &chunks[static_cast<size_t>(y / ChunkSize) * chunksX];
+        const uint32_t local = static_cast<uint32_t>((y % ChunkSize) * ChunkSize);
+
+        for (int column = first; column < last;)
+        {
+            const int count = std::min(ChunkSize - column % ChunkSize, last - column);
+            DecodeRange(row[column / ChunkSize], local + static_cast<uint32_t>(column % ChunkSize), static_cast<uint32_t>(count), &out[static_cast<size_t>(column - x)]);
+            column += count;
+        }
+    }
+
+    void TileChunkMap::ReadChunk(glm::ivec2 chunk, std::span<uint16_t, ChunkArea> out, uint16_t outside) const noexcept
+    {
+        const glm::ivec2 first = chunk * ChunkSize;
+
+        // Chunks entirely inside the map decode in one go.
+        if (first.x >= 0 && first.y >= 0 && first.x + ChunkSize <= width && first.y + ChunkSize <= height)
+        {
+            DecodeRange(chunks[static_cast<size_t>(chunk.y) * chunksX + chunk.x], 0, ChunkArea, out.data());
+            return;
+        }
+
+        for (int y = 0; y < ChunkSize; ++y) { ReadRow(first.y + y, first.x, out.subspan(static_cast<size_t>(y) * ChunkSize, ChunkSize), outside); }
+    }
+
+    std::vector<uint16_t> TileChunkMap::ToVector() const
+    {
+        std::vector<uint16_t> tiles(static_cast<size_t>(width) * height);
+
+        for (int y = 0; y < height; ++y) { ReadRow(y, 0, std::span {tiles}.subspan(static_cast<size_t>(y) * width, width)); }
+
+        return tiles;
+    }
+
+    bool TileChunkMap::IsUniform(glm::ivec2 chunk, uint16_t& id) const noexcept
+    {
+        const Chunk& stored = chunks[static_cast<size_t>(chunk.y) * chunksX + chunk.x];
+        if (stored.bits) { return false; }
+
+        id = stored.uniform;
+        return true;
+    }
+
+    MemoryUsage TileChunkMap::Memory() const noexcept
+    {
+        MemoryUsage usage = VectorMemory(chunks);
+
+        for (const Chunk& chunk : chunks)
+        {
+            usage += VectorMemory(chunk.palette);
+            usage += VectorMemory(chunk.words);
+        }
+
+        return usage;
+    }
+
+    void TileChunkMap::DecodeRange(const Chunk& chunk, uint32_t local, uint32_t count, uint16_t* out) noexcept
+    {
+        if (!chunk.bits)
+        {
+            std::fill_n(out, count, chunk.uniform);
+            return;
+        }
+
+        const uint32_t  bits  = chunk.bits;
+        const uint32_t  mask  = (1u << bits) - 1u;
+        const uint64_t* words = chunk.words.data();
+
+        if (bits == 16)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const uint32_t bit = (local + i) * 16;
+                out[i] = static_cast<uint16_t>(words[bit >> 6] >> (bit & 63));
+            }
+            return;
+        }
+
+        const uint16_t* palette = chunk.palette.data();
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t bit = (local + i) * bits;
+            out[i] = palette[static_cast<uint32_t>(words[bit >> 6] >> (bit & 63)) & mask];
+        }
+    }
+
+    void TileChunkMap::Encode(Chunk& chunk, const uint16_t* tiles)
+    {
+        // 1. Build the palette, giving up once it outgrows 8-bit indices. Tiles tend to repeat, so the last match is checked first.
+        std::array<uint8_t, ChunkArea> indices;
+        std::vector<uint16_t>          palette;
+        palette.reserve(16);
+
+        uint16_t lastTile  = tiles[0];
+        uint8_t  lastIndex = 0;
+        palette.push_back(lastTile);
+
+        bool raw = false;
+
+        for (size_t i = 0; i < ChunkArea && !raw; ++i)
+        {
+            if (tiles[i] != lastTile)
+            {
+                lastTile = tiles[i];
+
+                const auto   entry = std::ranges::find(palette, lastTile);
+                const size_t index = static_cast<size_t>(entry - palette.begin());
+
+                if (entry == palette.end())
+                {
+                    if (palette.size() == MAX_PALETTE) { raw = true; continue; }
+                    palette.push_back(lastTile);
+                }
+
+                lastIndex = static_cast<uint8_t>(index);
+            }
+
+            indices[i] = lastIndex;
+        }
+
+        // 2. Pick the narrowest width and pack.
+        if (palette.size() == 1 && !raw)
+        {
+            chunk.uniform = palette[0];
+            chunk.bits    = 0;
+            chunk.palette = std::vector<uint16_t> {};
+            chunk.words   = std::vector<uint64_t> {};
+            return;
+        }
+
+        const size_t distinct = palette.size();
+        chunk.bits = raw ? 16 : distinct <= 2 ? 1 : distinct <= 4 ? 2 : distinct <= 16 ? 4 : 8;
+
+        std::vector<uint64_t> words(static_cast<size_t>(ChunkArea) * chunk.bits / 64, 0);
+
+        for (uint32_t i = 0; i < ChunkArea; ++i)
+        {
+            const uint32_t bit = i * chunk.bits;
+            words[bit >> 6] |= static_cast<uint64_t>(raw ? tiles[i] : indices[i]) << (bit & 63);
+        }
+
+        chunk.words = std::move(words);
+
+        if (raw) { chunk.palette = std::vector<uint16_t> {}; }
+        else
+        {
+            palette.shrink_to_fit();
+            chunk.palette = std::move(palette);
+        }
+    }
+
+    void TileChunkMap::Gather(glm::ivec2 chunk, std::span<const uint16_t> tiles, uint16_t fill, uint16_t* out) const noexcept
+    {
+        const glm::ivec2 first = chunk * ChunkSize;
+        const int        rows  = std::min(ChunkSize, height - first.y);
+        const int        cols  = std::min(ChunkSize, width - first.x);
+
+        auto tileAt = [&](int x, int y) noexcept
+        {
+            const size_t index = static_cast<size_t>(y) * width + x;
+            return index < tiles.size() ? tiles[index] : fill;
+        };
+
+        const uint16_t padding = tileAt(first.x, first.y);
+
+        for (int y = 0; y < ChunkSize; ++y)
+        {
+            uint16_t* row = out + static_cast<size_t>(y) * ChunkSize;
+
+            if (y >= rows)
+            {
+                std::fill_n(row, ChunkSize, padding);
+                continue;
+            }
+
+            for (int x = 0; x < cols; ++x) { row[x] = tileAt(first.x + x, first.y + y); }
+            std::fill(row + cols, row + ChunkSize, padding);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef TERRANENGINE_TILECHUNKMAP_H
+#define TERRANENGINE_TILECHUNKMAP_H
+
+#include "engine/core/MemoryReport.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Compressed `width x height` grid of `uint16_t` tile IDs, stored as `ChunkSize x ChunkSize` chunks.
+     *
+     * ### Encodings.
+     *
+     * Each chunk is stored in the smallest of three forms:
+     *  - Uniform: every tile has the same ID, kept inline with no allocation.
+     *  - Palette: up to 256 distinct IDs, each tile stored as a 1, 2, 4 or 8-bit index into the chunk's palette.
+     *  - Raw: 16 bits per tile, for chunks with more than 256 distinct IDs.
+     *
+     * Indices are packed into 64-bit words. Power-of-two widths mean an index never straddles two words, so `Get` is O(1): a shift, a mask and a
+     * palette lookup.
+     *
+     * ### Editing.
+     *
+     * `Set` widens a chunk's encoding when it needs a new palette entry. It never narrows one, so IDs that are overwritten stay in the palette.
+     * Call `Compact` after heavy editing to re-encode every chunk at its smallest size.
+     *
+     * ### Iteration.
+     *
+     * `ReadRow` and `ReadChunk` decode a run of tiles at a time, which is much faster than calling `Get` per tile, and `IsUniform` lets callers skip
+     * or special-case whole chunks (e.g. a renderer emitting one quad, or a pathfinder treating a chunk as open).
+     */
+    class TileChunkMap
+    {
+    public:
+        static constexpr int ChunkSize = 32;
+        static constexpr int ChunkArea = ChunkSize * ChunkSize;
+
+        TileChunkMap() = default;
+        TileChunkMap(int width, int height, uint16_t fill = 0);
+
+        /** Replace every tile with `tiles` (`newWidth * newHeight`, row-major). Missing tiles are `fill`. */
+        void Assign(int newWidth, int newHeight, std::span<const uint16_t> tiles, uint16_t fill = 0);
+
+        /** Change one tile. Out of bounds tiles are ignored. */
+        void Set(glm::ivec2 tile, uint16_t id);
+
+        /** Re-encode every chunk at its smallest size, dropping palette entries no longer in use. */
+        void Compact();
+
+        [[nodiscard]] uint16_t Get(glm::ivec2 tile, uint16_t outside = 0) const noexcept
+        {
+            if (!InBounds(tile)) { return outside; }
+
+            const Chunk&   chunk = chunks[static_cast<size_t>(tile.y / ChunkSize) * chunksX + tile.x / ChunkSize];
+            const uint32_t local = static_cast<uint32_t>((tile.y % ChunkSize) * ChunkSize + tile.x % ChunkSize);
+            return Decode(chunk, local);
+        }
+
+        /** Copy `out.size()` tiles of row `y`, starting at column `x`. Tiles outside the map are `outside`. */
+        void ReadRow(int y, int x, std::span<uint16_t> out, uint16_t outside = 0) const noexcept;
+
+        /** Copy chunk `(x, y)` into `out` (`ChunkArea` tiles, row-major). Tiles outside the map are `outside`. */
+        void ReadChunk(glm::ivec2 chunk, std::span<uint16_t, ChunkArea> out, uint16_t outside = 0) const noexcept;
+
+        /** Every tile as one row-major array. */
+        [[nodiscard]] std::vector<uint16_t> ToVector() const;
+
+        /** True, with the ID in `id`, if every tile of chunk `(x, y)` holds the same ID. */
+        [[nodiscard]] bool IsUniform(glm::ivec2 chunk, uint16_t& id) const noexcept;
+
+        /** Bits stored per tile in chunk `(x, y)`: 0 for uniform chunks, 1 to 8 for palettes, 16 for raw. */
+        [[nodiscard]] int ChunkBits(glm::ivec2 chunk) const noexcept { return chunks[static_cast<size_t>(chunk.y) * chunksX + chunk.x].bits; }
+
+        [[nodiscard]] bool InBounds(glm::ivec2 tile) const noexcept { return tile.x >= 0 && tile.y >= 0 && tile.x < width && tile.y < height; }
+        [[nodiscard]] int  Width()   const noexcept { return width; }
+        [[nodiscard]] int  Height()  const noexcept { return height; }
+        [[nodiscard]] int  ChunksX() const noexcept { return chunksX; }
+        [[nodiscard]] int  ChunksY() const noexcept { return chunksY; }
+
+        [[nodiscard]] MemoryUsage Memory() const noexcept;
+
+    private:
+        struct Chunk
+        {
+            std::vector<uint16_t> palette; // Empty for uniform and raw chunks.
+            std::vector<uint64_t> words;   // `ChunkArea * bits` packed bits. Empty for uniform chunks.
+            uint16_t              uniform {0};
+            uint8_t               bits    {0};
+        };
+
+        [[nodiscard]] static uint16_t Decode(const Chunk& chunk, uint32_t local) noexcept
+        {
+            if (!chunk.bits) { return chunk.uniform; }
+
+            const uint32_t bit   = local * chunk.bits;
+            const uint32_t value = static_cast<uint32_t>(chunk.words[bit >> 6] >> (bit & 63)) & ((1u << chunk.bits) - 1u);
+            return chunk.bits == 16 ? static_cast<uint16_t>(value) : chunk.palette[value];
+        }
+
+        /** Decode `count` consecutive tiles of `chunk` from `local` onwards. */
+        static void DecodeRange(const Chunk& chunk, uint32_t local, uint32_t count, uint16_t* out) noexcept;
+
+        /** Encode a full chunk of tiles at the smallest width that fits. */
+        static void Encode(Chunk& chunk, const uint16_t* tiles);
+
+        /** Gather chunk `(x, y)` from a row-major map, padding tiles past the edge with the chunk's first tile so they never widen the palette. */
+        void Gather(glm::ivec2 chunk, std::span<const uint16_t> tiles, uint16_t fill, uint16_t* out) const noexcept;
+
+    private:
+        std::vector<Chunk> chunks; // Row-major.
+
+        int width   {0};
+        int height  {0};
+        int chunksX {0};
+        int chunksY {0};
+    };
+}
+
+#endif // TERRANENGINE_TILECHUNKMAP_H
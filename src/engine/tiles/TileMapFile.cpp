@@ -0,0 +1,220 @@
+#include "engine/tiles/TileMapFile.h"
+
+#include "engine/core/Log.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace TerranEngine
+{
+    static_assert(std::endian::native == std::endian::little, "TileMapFile reads tiles in place, which assumes a little-endian host.");
+
+    static constexpr char   MAGIC[4]        = { 'T', 'M', 'A', 'P' };
+    static constexpr size_t HEADER_SIZE     = 16;
+    static constexpr size_t LAYER_SIZE      = 16;
+    static constexpr size_t LAYER_ALIGNMENT = 16;
+
+    template<typename T>
+    static T ReadValue(const std::byte* bytes) noexcept
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static void WriteValue(std::vector<std::byte>& out, T value)
+    {
+        const std::byte* bytes = reinterpret_cast<const std::byte*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    /** `count, tile` pairs, each run at most 65535 tiles long. */
+    static std::vector<uint16_t> EncodeRuns(std::span<const uint16_t> tiles)
+    {
+        std::vector<uint16_t> runs;
+
+        for (size_t i = 0; i < tiles.size();)
+        {
+            const uint16_t tile = tiles[i];
+            size_t         end  = i + 1;
+            while (end < tiles.size() && tiles[end] == tile && end - i < 0xFFFF) { ++end; }
+
+            runs.push_back(static_cast<uint16_t>(end - i));
+            runs.push_back(tile);
+            i = end;
+        }
+
+        return runs;
+    }
+
+    static bool DecodeRuns(std::span<const std::byte> bytes, std::vector<uint16_t>& tiles)
+    {
+        size_t written = 0;
+
+        for (size_t i = 0; i + 4 <= bytes.size(); i += 4)
+        {
+            const uint16_t count = ReadValue<uint16_t>(&bytes[i]);
+            const uint16_t tile  = ReadValue<uint16_t>(&bytes[i + 2]);
+
+            if (count > tiles.size() - written) { return false; }
+
+            std::fill_n(tiles.begin() + static_cast<std::ptrdiff_t>(written), count, tile);
+            written += count;
+        }
+
+        return written == tiles.size();
+    }
+
+    bool TileMapFile::Load(std::string_view filePath)
+    {
+        MappedFile mappedFile;
+        mappedFile.Open(filePath); // Logs on failure; the unopened mapping then fails below.
+
+        return Load(std::move(mappedFile), filePath);
+    }
+
+    bool TileMapFile::Load(MappedFile&& mappedFile, std::string_view filePath)
+    {
+        layers.clear();
+        decoded.clear();
+        width  = 0;
+        height = 0;
+
+        file = std::move(mappedFile);
+        if (!file.IsOpen()) { return false; }
+
+        const std::span<const std::byte> bytes = file.Bytes();
+
+        // 1. Header.
+        if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0)
+        {
+            TE_LOG_ERROR("TileMapFile: '{}' is not a binary tile map.", filePath);
+            return false;
+        }
+
+        const uint16_t version    = ReadValue<uint16_t>(&bytes[4]);
+        const uint16_t layerCount = ReadValue<uint16_t>(&bytes[6]);
+        const uint32_t mapWidth   = ReadValue<uint32_t>(&bytes[8]);
+        const uint32_t mapHeight  = ReadValue<uint32_t>(&bytes[12]);
+
+        if (version != Version) { TE_LOG_ERROR("TileMapFile: '{}' has version {}, expected {}.", filePath, version, Version); return false; }
+
+        const uint64_t tileCount = static_cast<uint64_t>(mapWidth) * mapHeight;
+        const uint64_t rawBytes  = tileCount * sizeof(uint16_t);
+
+        if (bytes.size() < HEADER_SIZE + static_cast<size_t>(layerCount) * LAYER_SIZE || rawBytes > 0xFFFFFFFFu)
+        {
+            TE_LOG_ERROR("TileMapFile: '{}' has a truncated layer table or is too large.", filePath);
+            return false;
+        }
+
+        // 2. Layers. Raw layers point straight into the mapping, which is page-aligned, so aligned offsets give aligned tiles.
+        layers.reserve(layerCount);
+        decoded.reserve(layerCount);
+
+        for (size_t layer = 0; layer < layerCount; ++layer)
+        {
+            const std::byte* entry    = &bytes[HEADER_SIZE + layer * LAYER_SIZE];
+            const uint64_t   offset   = ReadValue<uint64_t>(entry);
+            const uint32_t   size     = ReadValue<uint32_t>(entry + 8);
+            const auto       encoding = static_cast<Encoding>(ReadValue<uint32_t>(entry + 12));
+
+            if (offset % alignof(uint16_t) != 0 || offset > bytes.size() || size > bytes.size() - offset)
+            {
+                TE_LOG_ERROR("TileMapFile: Layer {} of '{}' lies outside the file.", layer, filePath);
+                layers.clear();
+                return false;
+            }
+
+            const std::span<const std::byte> data = bytes.subspan(static_cast<size_t>(offset), size);
+
+            if (encoding == Encoding::Raw && size == rawBytes)
+            {
+                layers.emplace_back(reinterpret_cast<const uint16_t*>(data.data()), static_cast<size_t>(tileCount));
+            }
+            else if (encoding == Encoding::RunLength && size % 4 == 0)
+            {
+                std::vector<uint16_t>& tiles = decoded.emplace_back(static_cast<size_t>(tileCount));
+                if (!DecodeRuns(data, tiles))
+                {
+                    TE_LOG_ERROR("TileMapFile: Layer {} of '{}' does not decode to {} tiles.", layer, filePath, tileCount);
+                    layers.clear();
+                    return false;
+                }
+
+                layers.emplace_back(tiles);
+            }
+            else
+            {
+                TE_LOG_ERROR("TileMapFile: Layer {} of '{}' has an unknown encoding or the wrong size.", layer, filePath);
+                layers.clear();
+                return false;
+            }
+        }
+
+        width  = mapWidth;
+        height = mapHeight;
+        return true;
+    }
+
+    bool TileMapFile::Save(std::string_view filePath, uint32_t width, uint32_t height, std::span<const std::span<const uint16_t>> layers, bool compress)
+    {
+        const size_t tileCount = static_cast<size_t>(width) * height;
+
+        if (layers.size() > 0xFFFF || tileCount * sizeof(uint16_t) > 0xFFFFFFFFu)
+        {
+            TE_LOG_ERROR("TileMapFile: Too many layers or tiles to save '{}'.", filePath);
+            return false;
+        }
+
+        std::vector<std::byte> out;
+        out.insert(out.end(), reinterpret_cast<const std::byte*>(MAGIC), reinterpret_cast<const std::byte*>(MAGIC) + sizeof(MAGIC));
+        WriteValue<uint16_t>(out, Version);
+        WriteValue<uint16_t>(out, static_cast<uint16_t>(layers.size()));
+        WriteValue<uint32_t>(out, width);
+        WriteValue<uint32_t>(out, height);
+
+        // The layer table is filled in once each layer's offset is known.
+        out.resize(HEADER_SIZE + layers.size() * LAYER_SIZE);
+
+        for (size_t layer = 0; layer < layers.size(); ++layer)
+        {
+            if (layers[layer].size() != tileCount)
+            {
+                TE_LOG_ERROR("TileMapFile: Layer {} has {} tiles, expected {}.", layer, layers[layer].size(), tileCount);
+                return false;
+            }
+
+            std::vector<uint16_t> runs;
+            if (compress) { runs = EncodeRuns(layers[layer]); }
+
+            const bool                      encoded = compress && runs.size() < tileCount;
+            const std::span<const uint16_t> data    = encoded ? std::span<const uint16_t> {runs} : layers[layer];
+
+            out.resize((out.size() + LAYER_ALIGNMENT - 1) / LAYER_ALIGNMENT * LAYER_ALIGNMENT);
+
+            std::vector<std::byte> entry;
+            WriteValue<uint64_t>(entry, out.size());
+            WriteValue<uint32_t>(entry, static_cast<uint32_t>(data.size_bytes()));
+            WriteValue<uint32_t>(entry, static_cast<uint32_t>(encoded ? Encoding::RunLength : Encoding::Raw));
+            std::ranges::copy(entry, out.begin() + static_cast<std::ptrdiff_t>(HEADER_SIZE + layer * LAYER_SIZE));
+
+            const std::byte* dataBytes = reinterpret_cast<const std::byte*>(data.data());
+            out.insert(out.end(), dataBytes, dataBytes + data.size_bytes());
+        }
+
+        std::ofstream stream {std::string {filePath}, std::ios::binary | std::ios::trunc};
+        if (!stream || !stream.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size())))
+        {
+            TE_LOG_ERROR("TileMapFile: Failed to write '{}'.", filePath);
+            return false;
+        }
+
+        return true;
+    }
+}
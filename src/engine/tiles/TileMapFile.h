@@ -0,0 +1,68 @@
+#ifndef TERRANENGINE_TILEMAPFILE_H
+#define TERRANENGINE_TILEMAPFILE_H
+
+#include "engine/core/MappedFile.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace TerranEngine
+{
+    /**
+     * @brief Binary tile map (`.tmap`): a header, a layer table, then one `width * height` array of `uint16_t` tile IDs per layer.
+     *
+     * ### Layout.
+     *
+     * All values are little-endian.
+     *
+     *     Header      (16 bytes) : "TMAP", uint16 version, uint16 layer count, uint32 width, uint32 height.
+     *     Layer table (16 bytes per layer) : uint64 byte offset of the layer data, uint32 byte size, uint32 encoding.
+     *     Layer data  : each layer starts on a 16-byte boundary.
+     *
+     * Layers are either `Raw` (the tile array as is) or `RunLength` (`uint16 count, uint16 tile` pairs), whichever the writer found smaller.
+     *
+     * ### Loading.
+     *
+     * `Load` memory-maps the file and validates the header and layer table. `Raw` layers are then exposed straight from the mapping without
+     * being read or copied; `RunLength` layers are expanded once into memory owned by the `TileMapFile`.
+     */
+    class TileMapFile
+    {
+    public:
+        static constexpr uint16_t Version = 1;
+
+        enum class Encoding : uint32_t
+        {
+            Raw       = 0,
+            RunLength = 1
+        };
+
+        /** Map and validate `filePath`. Returns false (and logs) if the file is missing or malformed. */
+        bool Load(std::string_view filePath);
+
+        /** Validate a file that is already mapped, taking over the mapping. `filePath` only names it in log messages. */
+        bool Load(MappedFile&& mappedFile, std::string_view filePath);
+
+        /** Write `layers` (each `width * height` tiles, row-major) to `filePath`, run-length encoding layers where it saves space and `compress` is set. */
+        static bool Save(std::string_view filePath, uint32_t width, uint32_t height, std::span<const std::span<const uint16_t>> layers, bool compress = true);
+
+        [[nodiscard]] uint32_t Width()      const noexcept { return width; }
+        [[nodiscard]] uint32_t Height()     const noexcept { return height; }
+        [[nodiscard]] size_t   LayerCount() const noexcept { return layers.size(); }
+
+        /** Tiles of `layer`, row-major. Stays valid until the next `Load` or the TileMapFile is destroyed. */
+        [[nodiscard]] std::span<const uint16_t> Layer(size_t layer) const noexcept { return layer < layers.size() ? layers[layer] : std::span<const uint16_t> {}; }
+
+    private:
+        MappedFile                             file;
+        std::vector<std::span<const uint16_t>> layers;
+        std::vector<std::vector<uint16_t>>     decoded; // Storage for expanded `RunLength` layers.
+
+        uint32_t width  {0};
+        uint32_t height {0};
+    };
+}
+
+#endif // TERRANENGINE_TILEMAPFILE_H
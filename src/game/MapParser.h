@@ -2,12 +2,18 @@
 #define BHC_MAPPARSER_H
 
 #include "engine/core/Log.h"
+#include "engine/core/MappedFile.h"
+#include "engine/tiles/TileChunkMap.h"
+#include "engine/tiles/TileMapFile.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <vector>
-#include <cstdint>
-#include <fstream>
-#include <sstream>
 
 using namespace TerranEngine;
 
@@ -15,69 +21,147 @@ namespace BlackHoleChest
 {
     struct Map
     {
-        uint16_t width  {0};
-        uint16_t height {0};
-        std::vector<uint16_t> mapTiles;
+        uint16_t     width  {0};
+        uint16_t     height {0};
+        TileChunkMap tiles; // Row-major from the first line of the file, chunk-compressed.
     };
 
+    /**
+     * Loads a Map from any of the supported formats, detected from the file contents:
+     *  - Binary `.tmap` files written by `TileMapFile::Save` (first layer only).
+     *  - Grids: one row per line, tiles separated by commas, each row ending in `;` (e.g. `demo.map`).
+     *  - Lists: the width and the height, then `width * height` tiles, one value per line (e.g. `format.map`).
+     */
     class MapParser
     {
     public:
         static bool ParseMap(const std::string_view& filePath, Map& outMap)
         {
-            std::ifstream file {filePath.data()};
-
-            if (!file)
+            MappedFile file;
+            if (!file.Open(filePath))
             {
                 TE_LOG_ERROR("MapParser: Failed to load '{}'.", filePath);
                 return false;
             }
 
+            const std::string_view text {reinterpret_cast<const char*>(file.Bytes().data()), file.Size()};
+
+            if (text.starts_with("TMAP")) { return LoadBinary(std::move(file), filePath, outMap); }
+
             Map map;
-            std::string line;
 
-            // 1. Retrieve file header values (Width, Height).
-            if (!std::getline(file, line)) { TE_LOG_ERROR("MapParser: Missing width line in file '{}'", filePath); return false; }
-            if (!ParseUint16tFromLine(line, map.width)) { TE_LOG_ERROR("MapParser: Invalid width value in file '{}'.", filePath); return false; }
+            // 1. Grid files end every row with `;`, even single-column ones; lists never contain one.
+            const bool isGrid = text.find(';') != std::string_view::npos;
+
+            // 2. Parse every value in one pass. Separators are whitespace, `,` and `;`.
+            std::vector<uint16_t> values;
+            values.reserve(text.size() / 2);
+
+            size_t rows     = 0;
+            size_t rowStart = 0;
+            size_t rowWidth = 0;
+
+            const char* cursor = text.data();
+            const char* end    = text.data() + text.size();
+
+            while (cursor < end)
+            {
+                const char character = *cursor;
+
+                if (character == ';')
+                {
+                    if (!EndRow(values.size() - rowStart, rowWidth, rows, filePath)) { return false; }
+                    rowStart = values.size();
+                    ++cursor;
+                    continue;
+                }
+
+                if (character == ',' || character == ' ' || character == '\t' || character == '\r' || character == '\n') { ++cursor; continue; }
+
+                uint32_t value = 0;
+                const auto [next, error] = std::from_chars(cursor, end, value);
+
+                if (error != std::errc {} || value > std::numeric_limits<uint16_t>::max())
+                {
+                    TE_LOG_ERROR("MapParser: Invalid tile value '{}' in file '{}'.", std::string_view {cursor, static_cast<size_t>(std::min<std::ptrdiff_t>(end - cursor, 8))}, filePath);
+                    return false;
+                }
+
+                values.push_back(static_cast<uint16_t>(value));
+                cursor = next;
+            }
 
-            if (!std::getline(file, line)) { TE_LOG_ERROR("MapParser: Missing height line in file '{}'", filePath); return false; }
-            if (!ParseUint16tFromLine(line, map.height)) { TE_LOG_ERROR("MapParser: Invalid height value in file '{}'.", filePath); return false; }
+            // 3. Size the map from its rows (grids) or its header values (lists).
+            if (isGrid)
+            {
+                if (values.size() != rowStart && !EndRow(values.size() - rowStart, rowWidth, rows, filePath)) { return false; }
 
-            // 2. Parse the tiles making up the map.
-            const size_t mapSize = static_cast<size_t>(map.width * map.height);
-            map.mapTiles.resize(mapSize);
+                if (rowWidth > std::numeric_limits<uint16_t>::max() || rows > std::numeric_limits<uint16_t>::max())
+                {
+                    TE_LOG_ERROR("MapParser: Map '{}' is too large.", filePath);
+                    return false;
+                }
 
-            for (size_t i = 0; i < mapSize; ++i)
+                map.width  = static_cast<uint16_t>(rowWidth);
+                map.height = static_cast<uint16_t>(rows);
+                map.tiles.Assign(map.width, map.height, values);
+            }
+            else
             {
-                if (!std::getline(file, line)) { TE_LOG_ERROR("MapParser: Missing tile definition | {} / {}", i, map.width * map.height); return false; }
-                if (!ParseUint16tFromLine(line, map.mapTiles[i])) { TE_LOG_ERROR("MapParser: Invalid Tile value in file '{}'.", filePath); return false; }
+                if (values.size() < 2) { TE_LOG_ERROR("MapParser: Missing width or height in file '{}'.", filePath); return false; }
+
+                map.width  = values[0];
+                map.height = values[1];
+
+                const size_t mapSize = static_cast<size_t>(map.width) * map.height;
+                if (values.size() - 2 != mapSize)
+                {
+                    TE_LOG_ERROR("MapParser: Expected {} tiles in file '{}', found {}.", mapSize, filePath, values.size() - 2);
+                    return false;
+                }
+
+                map.tiles.Assign(map.width, map.height, std::span {values}.subspan(2));
             }
 
-            // 3. Output the new map struct into the injected input.
+            // 4. Output the new map struct into the injected input.
             outMap = std::move(map);
             return true;
         }
 
     private:
-        [[nodiscard]] static bool ParseUint16tFromLine(const std::string& line, uint16_t& integer16)
+        [[nodiscard]] static bool EndRow(size_t width, size_t& rowWidth, size_t& rows, const std::string_view& filePath)
         {
-            int integer32;
-            try
+            if (rows && width != rowWidth)
             {
-                integer32 = std::stoi(line);
+                TE_LOG_ERROR("MapParser: Row {} of '{}' has {} tiles, expected {}.", rows + 1, filePath, width, rowWidth);
+                return false;
             }
-            catch(const std::exception& exception)
+
+            rowWidth = width;
+            ++rows;
+            return true;
+        }
+
+        /** Read the first layer of a `.tmap` from its existing mapping, so the file is not opened twice. */
+        [[nodiscard]] static bool LoadBinary(MappedFile&& mappedFile, const std::string_view& filePath, Map& outMap)
+        {
+            TileMapFile file;
+            if (!file.Load(std::move(mappedFile), filePath) || !file.LayerCount()) { return false; }
+
+            if (file.Width() > std::numeric_limits<uint16_t>::max() || file.Height() > std::numeric_limits<uint16_t>::max())
             {
-                TE_LOG_ERROR("Exception: {}", exception.what());
+                TE_LOG_ERROR("MapParser: Map '{}' is too large.", filePath);
                 return false;
             }
 
-            if (integer32 < 0 || integer32 > std::numeric_limits<uint16_t>::max()) { TE_LOG_ERROR("MapParser: Invalid integer value in file."); return false;}
-            
-            integer16 = static_cast<uint16_t>(integer32);
+            const std::span<const uint16_t> tiles = file.Layer(0);
+
+            outMap.width  = static_cast<uint16_t>(file.Width());
+            outMap.height = static_cast<uint16_t>(file.Height());
+            outMap.tiles.Assign(outMap.width, outMap.height, tiles);
             return true;
-        };
+        }
     };
 }
 
-#endif // BHC_MAPPARSER_H
\ No newline at end of file
+#endif // BHC_MAPPARSER_H
@@ -44,12 +44,15 @@ int main()
     BlackHoleChest::Map map;
     BlackHoleChest::MapParser::ParseMap("../../assets/maps/format.map", map);
 
-    for (size_t i = 0; i < static_cast<size_t>(map.mapTiles.size()); ++i)
-    {
-        Entity tile = app.GetWorld().CreateEntity();
-        app.GetWorld().AddComponent<Transform2D>(tile, Transform2D{{(i / map.width) * 16, (i % map.width) * 16}});
-        app.GetWorld().AddComponent<Sprite>(tile, Sprite{mapAtlas, {16.0f, 16.0f}, map.mapTiles[i]});
-    }
+    // Row-major with the file's first row at the bottom, the same way `ChunkStreamer` streams a `.tmap` converted from this map.
+    // The chunked tiles are handed over as they are, and the Tilemap is offset by half a tile to keep tile centres on multiples of 16.
+    Tilemap tilemap;
+    tilemap.atlas = mapAtlas;
+    tilemap.Assign(std::move(map.tiles));
+
+    Entity terrain = app.GetWorld().CreateEntity();
+    app.GetWorld().AddComponent<Transform2D>(terrain, Transform2D{{-8.0f, -8.0f}});
+    app.GetWorld().AddComponent<Tilemap>(terrain, std::move(tilemap));
 
     app.Run();
     return 0;
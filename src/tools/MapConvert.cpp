@@ -0,0 +1,36 @@
+#include "engine/core/Log.h"
+#include "engine/tiles/TileMapFile.h"
+#include "game/MapParser.h"
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * Converts a text map (or an existing `.tmap`) into the binary `.tmap` format read by `TileMapFile`.
+ *
+ * Usage: terranengine_mapconvert <input.map> <output.tmap> [--raw]
+ * `--raw` stores tiles uncompressed, so the whole map can be used in place without decoding.
+ */
+int main(int argc, char** argv)
+{
+    using namespace TerranEngine;
+
+    if (argc < 3)
+    {
+        TE_LOG_ERROR("Usage: terranengine_mapconvert <input.map> <output.tmap> [--raw]");
+        return 1;
+    }
+
+    const bool compress = !(argc > 3 && std::string_view {argv[3]} == "--raw");
+
+    BlackHoleChest::Map map;
+    if (!BlackHoleChest::MapParser::ParseMap(argv[1], map)) { return 1; }
+
+    const std::vector<uint16_t>     tiles    = map.tiles.ToVector();
+    const std::span<const uint16_t> layers[] = { tiles };
+    if (!TileMapFile::Save(argv[2], map.width, map.height, layers, compress)) { return 1; }
+
+    TE_LOG_INFO("Converted '{}' ({} x {} tiles) to '{}'.", argv[1], map.width, map.height, argv[2]);
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "engine/core/Log.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/gfx/QuadExpand.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using namespace TerranEngine;
+
+    /** What `SpriteRenderer` holds for a queued sprite: its components, and UVs resolved while queueing. */
+    struct SpriteInput
+    {
+        Transform2D transform;
+        Sprite      sprite;
+        glm::vec4   uvRect;
+    };
+
+    constexpr int       ATLAS_WIDTH  = 512;
+    constexpr int       ATLAS_HEIGHT = 512;
+    constexpr glm::vec2 TILE_SIZE    {16.0f, 16.0f};
+
+    glm::vec2 RotateVec2(const glm::vec2& vector, float radians) noexcept
+    {
+        const float cos = std::cos(radians);
+        const float sin = std::sin(radians);
+        return { vector.x * cos - vector.y * sin, vector.x * sin + vector.y * cos };
+    }
+
+    /** `Texture::TileUV`, without needing a GL texture. */
+    void TileUV(uint32_t atlasIndex, glm::vec2& uvMin, glm::vec2& uvMax) noexcept
+    {
+        const int columns = ATLAS_WIDTH / static_cast<int>(TILE_SIZE.x);
+        const int column  = static_cast<int>(atlasIndex % columns);
+        const int row     = static_cast<int>(atlasIndex / columns);
+
+        const float inverseWidth  = 1.0f / static_cast<float>(ATLAS_WIDTH);
+        const float inverseHeight = 1.0f / static_cast<float>(ATLAS_HEIGHT);
+
+        uvMin = { column * TILE_SIZE.x * inverseWidth, 1.0f - (row + 1) * TILE_SIZE.y * inverseHeight };
+        uvMax = { uvMin.x + TILE_SIZE.x * inverseWidth, uvMin.y + TILE_SIZE.y * inverseHeight };
+    }
+
+    /** The per-sprite path `SpriteRenderer` used before `ExpandQuads`: UVs by division, and a sine and cosine per rotated vector. */
+    void ExpandLegacy(const std::vector<SpriteInput>& inputs, Vertex* out) noexcept
+    {
+        for (const SpriteInput& input : inputs)
+        {
+            const Transform2D& transform = input.transform;
+            const Sprite&      sprite    = input.sprite;
+
+            glm::vec2 uvMin;
+            glm::vec2 uvMax;
+            TileUV(sprite.atlasIndex, uvMin, uvMax);
+
+            const glm::vec2 size  = sprite.size * transform.scale;
+            const float     depth = static_cast<float>(sprite.zLevel) * 0.01f;
+
+            glm::vec2 localBL = { (0.0f - sprite.origin.x) * size.x, (0.0f - sprite.origin.y) * size.y };
+            glm::vec2 localBR = { (1.0f - sprite.origin.x) * size.x, (0.0f - sprite.origin.y) * size.y };
+            glm::vec2 localTR = { (1.0f - sprite.origin.x) * size.x, (1.0f - sprite.origin.y) * size.y };
+            glm::vec2 localTL = { (0.0f - sprite.origin.x) * size.x, (1.0f - sprite.origin.y) * size.y };
+
+            if (transform.rotation != 0.0f)
+            {
+                localBL = RotateVec2(localBL, transform.rotation);
+                localBR = RotateVec2(localBR, transform.rotation);
+                localTR = RotateVec2(localTR, transform.rotation);
+                localTL = RotateVec2(localTL, transform.rotation);
+            }
+
+            const glm::vec2 anchorOffset = RotateVec2(glm::vec2((sprite.origin.x - sprite.anchor.x) * size.x, (sprite.origin.y - sprite.anchor.y) * size.y), transform.rotation);
+            const glm::vec2 worldOrigin  = transform.position + anchorOffset;
+
+            *out++ = { worldOrigin + localBL, {uvMin.x, uvMin.y}, sprite.tint, depth };
+            *out++ = { worldOrigin + localBR, {uvMax.x, uvMin.y}, sprite.tint, depth };
+            *out++ = { worldOrigin + localTR, {uvMax.x, uvMax.y}, sprite.tint, depth };
+            *out++ = { worldOrigin + localTL, {uvMin.x, uvMax.y}, sprite.tint, depth };
+        }
+    }
+
+    /** Expand `[begin, end)` through `expand`, gathering `MakeQuadSource` results in groups of 64 the way `SpriteRenderer` does. */
+    template<typename Expand>
+    void ExpandRange(const std::vector<SpriteInput>& inputs, size_t begin, size_t end, Vertex* out, Expand expand) noexcept
+    {
+        constexpr size_t GROUP = 64;
+        QuadSource sources[GROUP];
+
+        for (size_t first = begin; first < end; first += GROUP)
+        {
+            const size_t last = std::min(end, first + GROUP);
+            for (size_t i = first; i < last; ++i) { sources[i - first] = MakeQuadSource(inputs[i].transform, inputs[i].sprite, inputs[i].uvRect); }
+
+            expand(sources, last - first, out + first * 4);
+        }
+    }
+
+    /** Mean milliseconds per call of `run` over `iterations`, after one warm-up call. */
+    template<typename Run>
+    double TimeMs(int iterations, Run run)
+    {
+        run();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) { run(); }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+    float MaxPositionError(const std::vector<Vertex>& a, const std::vector<Vertex>& b) noexcept
+    {
+        float worst = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            worst = std::max({worst, std::abs(a[i].position.x - b[i].position.x), std::abs(a[i].position.y - b[i].position.y)});
+        }
+
+        return worst;
+    }
+
+    /** Whether every vertex of `a` and `b` is bit-for-bit the same. */
+    bool Identical(const std::vector<Vertex>& a, const std::vector<Vertex>& b) noexcept
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Vertex)) == 0;
+    }
+}
+
+/**
+ * Microbenchmark of CPU sprite quad expansion: the per-sprite path `SpriteRenderer` used before `ExpandQuads`, against `ExpandQuadsScalar`
+ * and `ExpandQuads` on one thread, and `ExpandQuads` split over a `ThreadPool` with `ParallelFor`. Sources come from `MakeQuadSource`, as in
+ * `SpriteRenderer`.
+ *
+ * Usage: terranengine_quadbench [spriteCount = 200000] [iterations = 50]
+ */
+int main(int argc, char** argv)
+{
+    using namespace TerranEngine;
+
+    const size_t spriteCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const int    iterations  = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 50;
+
+    // Random sprites, three quarters of them rotated.
+    std::mt19937                          random {1234};
+    std::uniform_real_distribution<float> unit {0.0f, 1.0f};
+
+    const uint32_t tileCount = (ATLAS_WIDTH / 16) * (ATLAS_HEIGHT / 16);
+
+    std::vector<SpriteInput> inputs(spriteCount);
+    for (SpriteInput& input : inputs)
+    {
+        input.transform.position = { unit(random) * 4096.0f, unit(random) * 4096.0f };
+        input.transform.scale    = { 0.5f + unit(random), 0.5f + unit(random) };
+        input.transform.rotation = unit(random) < 0.25f ? 0.0f : unit(random) * 6.2831853f;
+
+        input.sprite.size       = TILE_SIZE;
+        input.sprite.anchor     = { unit(random), unit(random) };
+        input.sprite.atlasIndex = static_cast<uint32_t>(random() % tileCount);
+        input.sprite.tint       = { unit(random), unit(random), unit(random), 1.0f };
+
+        // Resolved once per sprite while queueing, as `SpriteRenderer` does through `TileUVTable`.
+        glm::vec2 uvMin;
+        glm::vec2 uvMax;
+        TileUV(input.sprite.atlasIndex, uvMin, uvMax);
+        input.uvRect = { uvMin.x, uvMin.y, uvMax.x, uvMax.y };
+    }
+
+    std::vector<Vertex> legacyOut(spriteCount * 4);
+    std::vector<Vertex> scalarOut(spriteCount * 4);
+    std::vector<Vertex> serialOut(spriteCount * 4);
+    std::vector<Vertex> parallelOut(spriteCount * 4);
+
+    ThreadPool workers;
+
+    const double legacyMs = TimeMs(iterations, [&] { ExpandLegacy(inputs, legacyOut.data()); });
+    const double scalarMs = TimeMs(iterations, [&] { ExpandRange(inputs, 0, spriteCount, scalarOut.data(), ExpandQuadsScalar); });
+    const double serialMs = TimeMs(iterations, [&] { ExpandRange(inputs, 0, spriteCount, serialOut.data(), ExpandQuads); });
+
+    const double parallelMs = TimeMs(iterations, [&]
+    {
+        workers.ParallelFor(spriteCount, 2048, [&](size_t begin, size_t end) { ExpandRange(inputs, begin, end, parallelOut.data(), ExpandQuads); });
+    });
+
+    // The kernels alone, over sources made in advance, without the sine and cosine of `MakeQuadSource`.
+    std::vector<QuadSource> sources(spriteCount);
+    for (size_t i = 0; i < spriteCount; ++i) { sources[i] = MakeQuadSource(inputs[i].transform, inputs[i].sprite, inputs[i].uvRect); }
+
+    const double scalarKernelMs = TimeMs(iterations, [&] { ExpandQuadsScalar(sources.data(), spriteCount, scalarOut.data()); });
+    const double kernelMs       = TimeMs(iterations, [&] { ExpandQuads(sources.data(), spriteCount, serialOut.data()); });
+
+    auto report = [&](std::string_view name, double ms)
+    {
+        TE_LOG_INFO("{:<28} {:8.3f} ms  {:6.2f} ns/sprite  x{:.2f}", name, ms, ms * 1e6 / static_cast<double>(std::max<size_t>(spriteCount, 1)), legacyMs / ms);
+    };
+
+    TE_LOG_INFO("Expanding {} sprites, mean of {} runs, parallel on {} threads:", spriteCount, iterations, workers.WorkerCount() + 1);
+    report("Legacy per-sprite", legacyMs);
+    report("ExpandQuadsScalar", scalarMs);
+    report("ExpandQuads", serialMs);
+    report("ExpandQuads, parallel", parallelMs);
+    report("Kernel only: scalar", scalarKernelMs);
+    report("Kernel only: ExpandQuads", kernelMs);
+
+    TE_LOG_INFO("Max corner difference from legacy: {}. ExpandQuads matches ExpandQuadsScalar exactly: {}.", MaxPositionError(legacyOut, scalarOut),
+                Identical(scalarOut, serialOut) && Identical(scalarOut, parallelOut));
+    return 0;
+}